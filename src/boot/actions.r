@@ -21,26 +21,26 @@ REBOL [
 
 add: action [
 	{Returns the addition of two values.}
-	value1 [scalar! date!]
+	value1 [scalar! date! vector!]
 	value2
 ]
 
 subtract: action [
 	{Returns the second value subtracted from the first.}
-	value1 [scalar! date!]
-	value2 [scalar! date!]
+	value1 [scalar! date! vector!]
+	value2 [scalar! date! vector!]
 ]
 
 multiply: action [
 	{Returns the first value multiplied by the second.}
-	value1 [scalar!]
-	value2 [scalar!]
+	value1 [scalar! vector!]
+	value2 [scalar! vector!]
 ]
 
 divide: action [
 	{Returns the first value divided by the second.}
-	value1 [scalar!]
-	value2 [scalar!]
+	value1 [scalar! vector!]
+	value2 [scalar! vector!]
 ]
 
 remainder: action [
@@ -379,6 +379,7 @@ open: action [
 	/seek  {Optimize for random access}
 	/allow {Specifies protection attributes}
 		access [block!]
+	/async {Complete reads and writes as port events (files)}
 ]
 
 close: action [
@@ -395,6 +396,7 @@ read: action [
 		index [number!]
 	/string {Convert UTF and line terminators to standard text string}
 	/lines {Convert to block of strings (implies /string)}
+	/mmap {Map the file into memory rather than copy it (fixed length binary)}
 ;	/as {Convert to string using a specified encoding}
 ;		encoding [none! number!] {UTF number (0 8 16 -16)}
 ]
@@ -402,7 +404,7 @@ read: action [
 write: action [
 	{Writes to a file, URL, or port - auto-converts text strings.}
 	destination [port! file! url! block!]
-	data [binary! string! block!] {Data to write (non-binary converts to UTF-8)}
+	data [binary! string! block! port!] {Data to write (non-binary converts to UTF-8)}
 	/part {Partial write a given number of units}
 		length [number!]
 	/seek {Write at a specific position}
@@ -445,3 +447,7 @@ rename: action [
 	to [port! file! url! block!]
 ]
 
+flush: action [
+	{Writes out data held by a port's write buffer.}
+	port [port!]
+]
@@ -100,6 +100,7 @@ Script: [
 
 	locked-word:        [{protected variable - cannot modify:} :arg1]
 	protected:          {protected value or series - cannot modify}
+	locked-series:      {series is in use by a view - cannot expand it}
 	hidden:             {not allowed - would expose or modify hidden values}
 	self-protected:     {cannot set/unset self - it is protected}
 	bad-bad:            [:arg1 {error:} :arg2]
@@ -380,7 +380,7 @@ checksum: native [
 	/hash {Returns a hash value}
 	size [integer!] {Size of the hash table}
 	/method {Method to use}
-	word [word!] {Methods: SHA1 MD5 CRC32}
+	word [word!] {Methods: SHA1 SHA256 MD5 CRC32}
 	/key {Returns keyed HMAC value}
 	key-value [any-string!] {Key to use}
 ]
@@ -390,6 +390,8 @@ compress: native [
 	data [binary! string!] {If string, it will be UTF8 encoded}
 	/part length {Length of data (elements)}
 	/gzip {Use GZIP checksum}
+	/threads {Compress large data in parallel blocks}
+	count [integer!] {Number of threads (0 for one per CPU)}
 ]
 
 decompress: native [
@@ -591,6 +593,17 @@ invalid-utf?: native [
 	num [integer!] "Bit size - positive for BE negative for LE"
 ]
 
+utf8-length?: native [
+	{Returns the number of chars in UTF-8 binary data (without decoding it).}
+	data [binary!]
+]
+
+utf8-at: native [
+	{Returns UTF-8 binary data at a char offset (without decoding it).}
+	data [binary!]
+	offset [integer! block!] {Chars to skip (zero based), or a block of them}
+]
+
 value?: native [
 	{Returns TRUE if the word has a value.}
 	value
@@ -824,6 +837,27 @@ shift: native [
 	/logical "Logical shift (sign bit ignored)"
 ]
 
+vector-sum: native [
+	{Returns the sum of all values of a vector.}
+	vector [vector!]
+]
+
+vector-min: native [
+	{Returns the smallest value of a vector (NONE if empty).}
+	vector [vector!]
+]
+
+vector-max: native [
+	{Returns the largest value of a vector (NONE if empty).}
+	vector [vector!]
+]
+
+vector-dot: native [
+	{Returns the dot product of two vectors of the same length.}
+	vector1 [vector!]
+	vector2 [vector!]
+]
+
 ;-- New, hackish stuff:
 
 ++: native [
@@ -932,6 +966,11 @@ do-codec: native [
 	handle [handle!] "Internal link to codec"
 	action [word!] "Decode, encode, identify"
 	data [binary! image!]
+	/scale {Decode an image reduced in size}
+	factor [integer!] {Divide width and height by this}
+	/part {Decode only a region of an image}
+	offset [pair!] {Top left corner in source pixels}
+	size [pair!]
 ]
 
 set-scheme: native [
@@ -990,6 +1029,14 @@ as-pair: native [
 	y [number!]
 ]
 
+as-vector: native [
+	{Returns a vector that uses the data of a binary directly (no copy).}
+	data [binary!] {Data from its current index (copied if the binary is later reallocated)}
+	type [block!] {Element type, such as: [decimal! 64] [unsigned integer! 16]}
+	/part {Limit the number of elements}
+	length [integer!]
+]
+
 ;read-file: native [f [file!]]
 
 equal?: native [
@@ -223,8 +223,23 @@ standard: context [
 	port-spec-net: make port-spec-head [
 		host: none
 		port-id: 80
+		reuse-port: none	; true: listeners share the port-id (SO_REUSEPORT)
 			none
 	]
+
+	port-spec-file: make port-spec-head [
+		buffer: none	; write buffer bytes (none or 0 to write through)
+	]
+
+	port-spec-checksum: make port-spec-head [
+		method: 'sha1
+	]
+
+	port-spec-zlib: make port-spec-head [
+		format: 'zlib	; zlib, gzip or raw
+		level: none		; 0 - 9 or none for default
+		target: none	; port to write output to
+	]
 	
 	file-info: context [
 		name:
@@ -29,6 +29,7 @@ buf-utf8		; UTF8 reused buffer
 buf-print		; temporary print output - used by raw print
 buf-form		; temporary form buffer - used by raw print
 buf-mold		; temporary mold buffer - used by mold
+buf-mold8		; byte-width mold buffer - used by mold
 mold-loop		; mold loop detection
 err-temps		; error temporaries
 
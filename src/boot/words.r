@@ -144,11 +144,17 @@ shift
 
 ; Checksum
 sha1
+sha256
 md4
 md5
 crc32
 adler32
 
+; Compression formats
+zlib
+gzip
+raw
+
 ; Codec actions
 identify
 decode
@@ -164,6 +170,9 @@ dns
 tcp
 udp
 clipboard
+checksum
+deflate
+inflate
 
 ; Gobs:
 gob
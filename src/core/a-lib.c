@@ -768,6 +768,7 @@ RL_API u32 RL_Set_Char(REBSER *series, u32 index, u32 chr)
 		index = series->tail;
 		EXPAND_SERIES_TAIL(series, 1);
 	}
+	if (PG_UTF8_Indexes) Free_UTF8_Index(series);
 	SET_ANY_CHAR(series, index, chr);
 	return index;
 }
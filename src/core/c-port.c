@@ -32,6 +32,7 @@
 #include "sys-core.h"
 
 #define MAX_WAIT_MS 64 // Maximum millsec to sleep
+#define OCID_MAX_WAIT 3 // OS_Config id (see host-lib.c)
 
 /***********************************************************************
 **
@@ -218,6 +219,7 @@
 	REBI64 base = OS_DELTA_TIME(0, 0);
 	REBCNT time;
 	REBINT result;
+	REBINT most;
 	REBCNT wt = 1;
 	REBCNT res = (timeout >= 1000) ? 0 : 16;  // OS dependent?
 
@@ -230,8 +232,10 @@
 		// Process any waiting events:
 		if ((result = Awake_System(ports)) > 0) return TRUE;
 
-		// If activity, use low wait time, otherwise increase it:
+		// If activity, use low wait time, otherwise increase it.
+		// When the host can wake on readiness, sleep it all:
 		if (result == 0) wt = 1;
+		else if ((most = OS_CONFIG(OCID_MAX_WAIT, 0)) > 0) wt = most;
 		else {
 			wt *= 2;
 			if (wt > MAX_WAIT_MS) wt = MAX_WAIT_MS;
@@ -511,7 +515,7 @@ xx*/	REBINT Wait_Device(REBREQ *req, REBCNT timeout)
 **
 ***********************************************************************/
 
-#define MAX_SCHEMES 10		// max native schemes
+#define MAX_SCHEMES 16		// max native schemes
 
 typedef struct rebol_scheme_actions {
 	REBCNT sym;
@@ -624,7 +628,10 @@ SCHEME_ACTIONS *Scheme_Actions;	// Initial Global (not threaded)
 	Init_Dir_Scheme();
 	Init_Event_Scheme();
 	Init_TCP_Scheme();
+	Init_UDP_Scheme();
 	Init_DNS_Scheme();
+	Init_Checksum_Scheme();
+	Init_Compress_Scheme();
 #ifndef MIN_OS
 	Init_Clipboard_Scheme();
 #endif
@@ -30,6 +30,13 @@
 #include "sys-core.h"
 #include "sys-scan.h"
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+#ifdef __SSSE3__
+#include <tmmintrin.h>
+#endif
+
 
 /***********************************************************************
 **
@@ -172,6 +179,145 @@
 };
 
 
+#ifdef __SSSE3__
+/***********************************************************************
+**
+*/	static REBYTE *Enbase64_16(REBYTE *p, REBYTE *src)
+/*
+**		Encode 12 bytes into 16 base-64 chars. Reads 16 bytes.
+**
+***********************************************************************/
+{
+	__m128i in, t0, t1, idx, res, less;
+
+	// Spread each 3 bytes into a 32 bit lane (b1 b0 b2 b1 order):
+	in = _mm_loadu_si128((__m128i*)src);
+	in = _mm_shuffle_epi8(in, _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+
+	// Extract the four 6 bit indexes of each lane into its bytes:
+	t0 = _mm_mulhi_epu16(_mm_and_si128(in, _mm_set1_epi32(0x0fc0fc00)), _mm_set1_epi32(0x04000040));
+	t1 = _mm_mullo_epi16(_mm_and_si128(in, _mm_set1_epi32(0x003f03f0)), _mm_set1_epi32(0x01000010));
+	idx = _mm_or_si128(t0, t1);
+
+	// Map the indexes to ASCII by adding a per-range offset:
+	res = _mm_subs_epu8(idx, _mm_set1_epi8(51));
+	less = _mm_cmpgt_epi8(_mm_set1_epi8(26), idx);
+	res = _mm_or_si128(res, _mm_and_si128(less, _mm_set1_epi8(13)));
+	res = _mm_shuffle_epi8(_mm_setr_epi8(
+		'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+		'0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0), res);
+	res = _mm_add_epi8(res, idx);
+
+	_mm_storeu_si128((__m128i*)p, res);
+	return p + 16;
+}
+
+
+/***********************************************************************
+**
+*/	static REBFLG Debase64_16(REBYTE *bp, REBYTE *cp)
+/*
+**		Decode 16 base-64 chars into 12 bytes. Writes 16 bytes.
+**		Returns FALSE (and writes nothing) if any char is not in
+**		the base-64 alphabet, so the caller can handle it.
+**
+***********************************************************************/
+{
+	__m128i in, hi, lo, roll, vals;
+
+	in = _mm_loadu_si128((__m128i*)cp);
+	hi = _mm_and_si128(_mm_srli_epi32(in, 4), _mm_set1_epi8(0x0f));
+	lo = _mm_and_si128(in, _mm_set1_epi8(0x0f));
+
+	// Nibble bitmaps that only intersect for invalid chars:
+	lo = _mm_shuffle_epi8(_mm_setr_epi8(
+		0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+		0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A), lo);
+	roll = _mm_shuffle_epi8(_mm_setr_epi8(
+		0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+		0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10), hi);
+	if (_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_and_si128(lo, roll), _mm_setzero_si128())))
+		return FALSE;
+
+	// Chars to 6 bit values (offset by high nibble, '/' special):
+	roll = _mm_add_epi8(_mm_cmpeq_epi8(in, _mm_set1_epi8('/')), hi);
+	roll = _mm_shuffle_epi8(_mm_setr_epi8(
+		0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0), roll);
+	vals = _mm_add_epi8(in, roll);
+
+	// Pack 4 x 6 bits into 3 bytes per lane:
+	vals = _mm_maddubs_epi16(vals, _mm_set1_epi32(0x01400140));
+	vals = _mm_madd_epi16(vals, _mm_set1_epi32(0x00011000));
+	vals = _mm_shuffle_epi8(vals, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+
+	_mm_storeu_si128((__m128i*)bp, vals);
+	return TRUE;
+}
+#endif
+
+
+#ifdef __SSE2__
+/***********************************************************************
+**
+*/	static REBYTE *Enbase16_16(REBYTE *bp, REBYTE *src)
+/*
+**		Encode 16 bytes into 32 hex digits (upper case).
+**
+***********************************************************************/
+{
+	__m128i in, hi, lo, a, b;
+	const __m128i nine = _mm_set1_epi8(9);
+	const __m128i zero = _mm_set1_epi8('0');
+	const __m128i gap = _mm_set1_epi8('A' - '0' - 10);
+
+	in = _mm_loadu_si128((__m128i*)src);
+	hi = _mm_and_si128(_mm_srli_epi16(in, 4), _mm_set1_epi8(0x0f));
+	lo = _mm_and_si128(in, _mm_set1_epi8(0x0f));
+
+	// Interleave so the high nibble comes first:
+	a = _mm_unpacklo_epi8(hi, lo);
+	b = _mm_unpackhi_epi8(hi, lo);
+	a = _mm_add_epi8(_mm_add_epi8(a, zero), _mm_and_si128(_mm_cmpgt_epi8(a, nine), gap));
+	b = _mm_add_epi8(_mm_add_epi8(b, zero), _mm_and_si128(_mm_cmpgt_epi8(b, nine), gap));
+
+	_mm_storeu_si128((__m128i*)bp, a);
+	_mm_storeu_si128((__m128i*)(bp + 16), b);
+	return bp + 32;
+}
+
+
+/***********************************************************************
+**
+*/	static REBFLG Debase16_32(REBYTE *bp, REBYTE *cp)
+/*
+**		Decode 32 hex digits into 16 bytes. Returns FALSE (and
+**		writes nothing) if any char is not a hex digit.
+**
+***********************************************************************/
+{
+	__m128i in, d, a, dig, alf, nib[2];
+	const __m128i none = _mm_set1_epi8(-1);
+	REBINT n;
+
+	for (n = 0; n < 2; n++) {
+		in = _mm_loadu_si128((__m128i*)(cp + 16 * n));
+		d = _mm_sub_epi8(in, _mm_set1_epi8('0'));
+		a = _mm_sub_epi8(_mm_or_si128(in, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+		dig = _mm_and_si128(_mm_cmpgt_epi8(d, none), _mm_cmplt_epi8(d, _mm_set1_epi8(10)));
+		alf = _mm_and_si128(_mm_cmpgt_epi8(a, none), _mm_cmplt_epi8(a, _mm_set1_epi8(6)));
+		if (_mm_movemask_epi8(_mm_or_si128(dig, alf)) != 0xFFFF) return FALSE;
+		a = _mm_add_epi8(a, _mm_set1_epi8(10));
+		d = _mm_or_si128(_mm_and_si128(dig, d), _mm_andnot_si128(dig, a));
+		// Each 16 bit lane holds a digit pair, first digit in low byte:
+		nib[n] = _mm_and_si128(_mm_or_si128(_mm_slli_epi16(d, 4), _mm_srli_epi16(d, 8)), _mm_set1_epi16(0xff));
+	}
+
+	_mm_storeu_si128((__m128i*)bp, _mm_packus_epi16(nib[0], nib[1]));
+	return TRUE;
+}
+#endif
+
+
 /***********************************************************************
 **
 */	static REBSER *Decode_Base2(REBYTE **src, REBCNT len, REBYTE delim)
@@ -235,6 +381,10 @@ err:
 	REBYTE lex;
 	REBINT val;
 	REBSER *ser;
+#ifdef __SSE2__
+	// Fast path is not used if the delimiter could be a digit:
+	REBOOL fast = !delim || Lex_Map[delim] <= LEX_WORD;
+#endif
 
 	ser = Make_Binary(len / 2);
 	bp = STR_HEAD(ser);
@@ -242,6 +392,16 @@ err:
 
 	for (; len > 0; cp++, len--) {
 
+#ifdef __SSE2__
+		// Decode runs of 32 plain hex digits at once:
+		while (fast && !(count & 1) && len > 32 && Debase16_32(bp, cp)) {
+			bp += 16;
+			cp += 32;
+			len -= 32;
+			count += 32;
+		}
+#endif
+
 		if (delim && *cp == delim) break;
 
 		lex = Lex_Map[*cp];
@@ -279,6 +439,10 @@ err:
 	REBINT accum = 0;
 	REBYTE lex;
 	REBSER *ser;
+#ifdef __SSSE3__
+	// Fast path is not used if the delimiter could be a base-64 char:
+	REBOOL fast = !delim || delim > 127 || Debase64[delim] >= BIN_SPACE;
+#endif
 
 	// Allocate buffer large enough to hold result:
 	// Accounts for e bytes decoding into 3 bytes.
@@ -288,6 +452,16 @@ err:
 
 	for (; len > 0; cp++, len--) {
 
+#ifdef __SSSE3__
+		// Decode runs of 16 plain base-64 chars at once. The output
+		// has room for the 16 byte store while 24 or more chars remain.
+		while (fast && !flip && len >= 24 && Debase64_16(bp, cp)) {
+			bp += 12;
+			cp += 16;
+			len -= 16;
+		}
+#endif
+
 		// Check for terminating delimiter (optional):
 		if (delim && *cp == delim) break;
 
@@ -438,7 +612,17 @@ err:
 	// (Note: tail not properly set yet)
 
 	if (len >= 32 && brk) *bp++ = LF;
-	for (count = 1; count <= len; count++) {
+	count = 1;
+#ifdef __SSE2__
+	// Whole lines of 32 bytes:
+	for (; count + 31 <= len; count += 32) {
+		bp = Enbase16_16(bp, src);
+		bp = Enbase16_16(bp, src + 16);
+		src += 32;
+		if (brk) *bp++ = LF;
+	}
+#endif
+	for (; count <= len; count++) {
 		bp = Form_Hex2(bp, *src++);
 		if (brk && ((count % 32) == 0)) *bp++ = LF;
 	}
@@ -473,7 +657,18 @@ err:
 	loop = (int) (len / 3) - 1;
 	if (4 * loop > 64 && brk) *p++ = LF;
 
- 	for (x = 0; x <= 3 * loop; x += 3) {
+	x = 0;
+#ifdef __SSSE3__
+	// Whole lines of 48 bytes (the last load reads 4 bytes beyond):
+	for (; (REBCNT)x + 52 <= len; x += 48) {
+		p = Enbase64_16(p, src + x);
+		p = Enbase64_16(p, src + x + 12);
+		p = Enbase64_16(p, src + x + 24);
+		p = Enbase64_16(p, src + x + 36);
+		if (brk) *p++ = LF;
+	}
+#endif
+ 	for (; x <= 3 * loop; x += 3) {
 		*p++ = Enbase64[src[x] >> 2];
 		*p++ = Enbase64[((src[x] & 0x3) << 4) + (src[x + 1] >> 4)];
 		*p++ = Enbase64[((src[x + 1] & 0xF) << 2) + (src[x + 2] >> 6)];
@@ -450,6 +450,8 @@ x*/	int Do_Callback(REBSER *obj, u32 name, RXIARG *args, RXIARG *result)
 	for (n = 1; n <= argc; n++, val++) {
 		RXA_TYPE(&frm, n) = Reb_To_RXT[VAL_TYPE(val)];
 		frm.args[n] = Value_To_RXI(val);
+		// The command may modify a binary (e.g. RC4):
+		if (PG_UTF8_Indexes && IS_BINARY(val)) Free_UTF8_Index(VAL_SERIES(val));
 	}
 
 	// Call the command:
@@ -98,6 +98,12 @@
 }
 
 
+static const char Digit_Pairs[] =
+	"00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+	"40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+	"8081828384858687888990919293949596979899";
+
+
 /***********************************************************************
 **
 */	REBINT Form_Int_Len(REBYTE *buf, REBI64 val, REBINT maxl)
@@ -114,10 +120,12 @@
 ***********************************************************************/
 {
 	REBYTE tmp[MAX_NUM_LEN];
-	REBYTE *tp = tmp;
-	REBI64 n;
-	REBI64 r;
-	REBINT len = 0;
+	REBYTE *tp = tmp + MAX_NUM_LEN;
+	REBU64 u;
+	REBU64 q;
+	REBCNT n;
+	REBINT len;
+	REBINT i;
 
 	// defaults for problem cases
 	buf[0] = '?';
@@ -125,36 +133,46 @@
 
 	if (maxl == 0) return 0;
 
-	if (val == 0) {
-		*buf++ = '0';
-		*buf = 0;
-		return 1;
+	// (Unsigned, so the 0x8000... case needs no special handling.)
+	u = (val < 0) ? (REBU64)0 - (REBU64)val : (REBU64)val;
+
+	// Generate string in reverse, two digits per step. Eight
+	// digits at a time are split off first, so that 64 bit
+	// division (slow on 32 bit CPUs) is done at most twice:
+	while (u >= 100000000) {
+		q = u / 100000000;
+		n = (REBCNT)(u - q * 100000000);
+		u = q;
+		for (i = 0; i < 4; i++) {
+			tp -= 2;
+			memcpy(tp, Digit_Pairs + (n % 100) * 2, 2);
+			n /= 100;
+		}
+	}
+	n = (REBCNT)u;
+	while (n >= 100) {
+		tp -= 2;
+		memcpy(tp, Digit_Pairs + (n % 100) * 2, 2);
+		n /= 100;
 	}
+	if (n >= 10) {
+		tp -= 2;
+		memcpy(tp, Digit_Pairs + n * 2, 2);
+	}
+	else *--tp = (REBYTE)('0' + n);
+
+	len = tmp + MAX_NUM_LEN - tp;
+	if (len > ((val < 0) ? maxl - 1 : maxl)) return 0;
 
 	if (val < 0) {
-		val = -val;
 		*buf++ = '-';
-		maxl--;
-		len = 1;
-	}
-
-	// Generate string in reverse:
-	*tp++ = 0;
-	while (val != 0) {
-		n = val / 10;	// not using ldiv for easier compatibility
-		r = val % 10;
-		if (r < 0) {	// check for overflow case when val = 0x80000000...
-			r = -r;
-			n = -n;
-		}
-		*tp++ = (REBYTE)('0' + (REBYTE)(r));
-		val = n;
+		memcpy(buf, tp, len);
+		buf[len] = 0;
+		return len + 1;
 	}
-	tp--;
-
-	if (tp - tmp > maxl) return 0;
 
-	while (NZ(*buf++ = *tp--)) len++;
+	memcpy(buf, tp, len);
+	buf[len] = 0;
 	return len;
 }
 
@@ -220,8 +238,7 @@
 **
 ***********************************************************************/
 {
-	INT_TO_STR(val, buf);
-	return buf+LEN_BYTES(buf);
+	return buf + Form_Int_Len(buf, val, MAX_NUM_LEN);
 }
 
 
@@ -231,8 +248,7 @@
 /*
 ***********************************************************************/
 {
-	INT_TO_STR(val, buf);
-	return LEN_BYTES(buf);
+	return Form_Int_Len(buf, val, MAX_NUM_LEN);
 }
 
 
@@ -390,17 +406,270 @@ static int Convert_Decimal(REBDEC d, REBI64 *sig, REBINT *point)
 /* this is appropriate for 64-bit IEEE754 binary floating point format */
 #define MAX_DIGITS 17
 
+/***********************************************************************
+**
+**	Grisu3 shortest digits (Florian Loitsch, "Printing Floating-Point
+**	Numbers Quickly and Accurately with Integers", PLDI 2010).
+**
+**	Produces the same digits as dtoa mode 0 (shortest round trip,
+**	closest to the value) using only 64 bit integer math. For the few
+**	values (about 0.5%) where it cannot prove the result, it fails
+**	and the caller uses dtoa.
+**
+***********************************************************************/
+
+typedef struct {
+	REBU64 f;
+	REBINT e;
+} DIYFP;
+
+static const struct {
+	REBCNT hi, lo;	// significand
+	short  e;		// binary exponent
+	short  k;		// decimal exponent
+} Cached_Powers[] = {	// 10^k for k = -348 to 340, step 8
+	{0xfa8fd5a0, 0x081c0288, -1220, -348},
+	{0xbaaee17f, 0xa23ebf76, -1193, -340},
+	{0x8b16fb20, 0x3055ac76, -1166, -332},
+	{0xcf42894a, 0x5dce35ea, -1140, -324},
+	{0x9a6bb0aa, 0x55653b2d, -1113, -316},
+	{0xe61acf03, 0x3d1a45df, -1087, -308},
+	{0xab70fe17, 0xc79ac6ca, -1060, -300},
+	{0xff77b1fc, 0xbebcdc4f, -1034, -292},
+	{0xbe5691ef, 0x416bd60c, -1007, -284},
+	{0x8dd01fad, 0x907ffc3c, -980, -276},
+	{0xd3515c28, 0x31559a83, -954, -268},
+	{0x9d71ac8f, 0xada6c9b5, -927, -260},
+	{0xea9c2277, 0x23ee8bcb, -901, -252},
+	{0xaecc4991, 0x4078536d, -874, -244},
+	{0x823c1279, 0x5db6ce57, -847, -236},
+	{0xc2109436, 0x4dfb5637, -821, -228},
+	{0x9096ea6f, 0x3848984f, -794, -220},
+	{0xd77485cb, 0x25823ac7, -768, -212},
+	{0xa086cfcd, 0x97bf97f4, -741, -204},
+	{0xef340a98, 0x172aace5, -715, -196},
+	{0xb23867fb, 0x2a35b28e, -688, -188},
+	{0x84c8d4df, 0xd2c63f3b, -661, -180},
+	{0xc5dd4427, 0x1ad3cdba, -635, -172},
+	{0x936b9fce, 0xbb25c996, -608, -164},
+	{0xdbac6c24, 0x7d62a584, -582, -156},
+	{0xa3ab6658, 0x0d5fdaf6, -555, -148},
+	{0xf3e2f893, 0xdec3f126, -529, -140},
+	{0xb5b5ada8, 0xaaff80b8, -502, -132},
+	{0x87625f05, 0x6c7c4a8b, -475, -124},
+	{0xc9bcff60, 0x34c13053, -449, -116},
+	{0x964e858c, 0x91ba2655, -422, -108},
+	{0xdff97724, 0x70297ebd, -396, -100},
+	{0xa6dfbd9f, 0xb8e5b88f, -369, -92},
+	{0xf8a95fcf, 0x88747d94, -343, -84},
+	{0xb9447093, 0x8fa89bcf, -316, -76},
+	{0x8a08f0f8, 0xbf0f156b, -289, -68},
+	{0xcdb02555, 0x653131b6, -263, -60},
+	{0x993fe2c6, 0xd07b7fac, -236, -52},
+	{0xe45c10c4, 0x2a2b3b06, -210, -44},
+	{0xaa242499, 0x697392d3, -183, -36},
+	{0xfd87b5f2, 0x8300ca0e, -157, -28},
+	{0xbce50864, 0x92111aeb, -130, -20},
+	{0x8cbccc09, 0x6f5088cc, -103, -12},
+	{0xd1b71758, 0xe219652c, -77, -4},
+	{0x9c400000, 0x00000000, -50, 4},
+	{0xe8d4a510, 0x00000000, -24, 12},
+	{0xad78ebc5, 0xac620000, 3, 20},
+	{0x813f3978, 0xf8940984, 30, 28},
+	{0xc097ce7b, 0xc90715b3, 56, 36},
+	{0x8f7e32ce, 0x7bea5c70, 83, 44},
+	{0xd5d238a4, 0xabe98068, 109, 52},
+	{0x9f4f2726, 0x179a2245, 136, 60},
+	{0xed63a231, 0xd4c4fb27, 162, 68},
+	{0xb0de6538, 0x8cc8ada8, 189, 76},
+	{0x83c7088e, 0x1aab65db, 216, 84},
+	{0xc45d1df9, 0x42711d9a, 242, 92},
+	{0x924d692c, 0xa61be758, 269, 100},
+	{0xda01ee64, 0x1a708dea, 295, 108},
+	{0xa26da399, 0x9aef774a, 322, 116},
+	{0xf209787b, 0xb47d6b85, 348, 124},
+	{0xb454e4a1, 0x79dd1877, 375, 132},
+	{0x865b8692, 0x5b9bc5c2, 402, 140},
+	{0xc83553c5, 0xc8965d3d, 428, 148},
+	{0x952ab45c, 0xfa97a0b3, 455, 156},
+	{0xde469fbd, 0x99a05fe3, 481, 164},
+	{0xa59bc234, 0xdb398c25, 508, 172},
+	{0xf6c69a72, 0xa3989f5c, 534, 180},
+	{0xb7dcbf53, 0x54e9bece, 561, 188},
+	{0x88fcf317, 0xf22241e2, 588, 196},
+	{0xcc20ce9b, 0xd35c78a5, 614, 204},
+	{0x98165af3, 0x7b2153df, 641, 212},
+	{0xe2a0b5dc, 0x971f303a, 667, 220},
+	{0xa8d9d153, 0x5ce3b396, 694, 228},
+	{0xfb9b7cd9, 0xa4a7443c, 720, 236},
+	{0xbb764c4c, 0xa7a44410, 747, 244},
+	{0x8bab8eef, 0xb6409c1a, 774, 252},
+	{0xd01fef10, 0xa657842c, 800, 260},
+	{0x9b10a4e5, 0xe9913129, 827, 268},
+	{0xe7109bfb, 0xa19c0c9d, 853, 276},
+	{0xac2820d9, 0x623bf429, 880, 284},
+	{0x80444b5e, 0x7aa7cf85, 907, 292},
+	{0xbf21e440, 0x03acdd2d, 933, 300},
+	{0x8e679c2f, 0x5e44ff8f, 960, 308},
+	{0xd433179d, 0x9c8cb841, 986, 316},
+	{0x9e19db92, 0xb4e31ba9, 1013, 324},
+	{0xeb96bf6e, 0xbadf77d9, 1039, 332},
+	{0xaf87023b, 0x9bf0ee6b, 1066, 340},
+};
+
+#define CACHED_POWERS_OFFSET 348
+#define CACHED_POWERS_STEP 8
+
+static DIYFP Diy_Mul(DIYFP x, DIYFP y)
+{
+	// Upper 64 bits of the 128 bit product, rounded:
+	REBU64 a = x.f >> 32, b = x.f & 0xFFFFFFFF;
+	REBU64 c = y.f >> 32, d = y.f & 0xFFFFFFFF;
+	REBU64 ac = a * c, bc = b * c, ad = a * d, bd = b * d;
+	REBU64 tmp = (bd >> 32) + (ad & 0xFFFFFFFF) + (bc & 0xFFFFFFFF) + ((REBU64)1 << 31);
+	DIYFP r;
+
+	r.f = ac + (ad >> 32) + (bc >> 32) + (tmp >> 32);
+	r.e = x.e + y.e + 64;
+	return r;
+}
+
+static DIYFP Diy_Norm(DIYFP x)
+{
+	while (!(x.f & ((REBU64)1 << 63))) {
+		x.f <<= 1;
+		x.e--;
+	}
+	return x;
+}
+
+static REBFLG Round_Weed(REBYTE *buf, REBINT len, REBU64 dist_high_w, REBU64 unsafe, REBU64 rest, REBU64 ten_kappa, REBU64 unit)
+{
+	REBU64 small_dist = dist_high_w - unit;
+	REBU64 big_dist = dist_high_w + unit;
+
+	// Move the last digit down while it gets closer to w:
+	while (rest < small_dist && unsafe - rest >= ten_kappa
+		&& (rest + ten_kappa < small_dist || small_dist - rest >= rest + ten_kappa - small_dist)
+	) {
+		buf[len - 1]--;
+		rest += ten_kappa;
+	}
+
+	// Fail if another digit could be closer:
+	if (rest < big_dist && unsafe - rest >= ten_kappa
+		&& (rest + ten_kappa < big_dist || big_dist - rest > rest + ten_kappa - big_dist)
+	) return FALSE;
+
+	// Must be safely inside the interval:
+	return (2 * unit <= rest) && (rest <= unsafe - 4 * unit);
+}
+
+static REBFLG Grisu_Digits(REBDEC d, REBYTE *buf, REBINT *len, REBINT *decpt)
+{
+	// Digits of finite positive d into buf (no terminator).
+	// Returns FALSE if the result cannot be guaranteed.
+	union {REBDEC d; REBU64 u;} bits;
+	DIYFP w, lo, hi, c, one, too_lo, too_hi;
+	REBU64 frac, unit = 1, unsafe, rest, fractionals;
+	REBCNT integrals, divisor;
+	REBINT bexp, mk, kappa, n, i;
+
+	bits.d = d;
+	frac = bits.u & (((REBU64)1 << 52) - 1);
+	bexp = (REBINT)((bits.u >> 52) & 0x7FF);
+
+	if (bexp) {
+		w.f = frac | ((REBU64)1 << 52);
+		w.e = bexp - 1075;
+	} else {
+		w.f = frac;
+		w.e = -1074;
+	}
+
+	// Boundaries half way to the neighbor values:
+	hi.f = (w.f << 1) + 1;
+	hi.e = w.e - 1;
+	hi = Diy_Norm(hi);
+	if (frac == 0 && bexp > 1) {
+		lo.f = (w.f << 2) - 1; // lower neighbor is closer
+		lo.e = w.e - 2;
+	} else {
+		lo.f = (w.f << 1) - 1;
+		lo.e = w.e - 1;
+	}
+	lo.f <<= lo.e - hi.e;
+	lo.e = hi.e;
+	w = Diy_Norm(w);
+
+	// Cached power of ten to scale w into binary exponent -60..-32:
+	n = (REBINT)ceil((-60 - (w.e + 64) + 63) * 0.30102999566398114);
+	i = (CACHED_POWERS_OFFSET + n - 1) / CACHED_POWERS_STEP + 1;
+	c.f = (REBU64)Cached_Powers[i].hi << 32 | Cached_Powers[i].lo;
+	c.e = Cached_Powers[i].e;
+	mk = Cached_Powers[i].k;
+
+	w = Diy_Mul(w, c);
+	lo = Diy_Mul(lo, c);
+	hi = Diy_Mul(hi, c);
+
+	// Generate digits (the unsafe interval widens by one unit each way):
+	too_lo.f = lo.f - unit;
+	too_hi.f = hi.f + unit;
+	unsafe = too_hi.f - too_lo.f;
+	one.e = w.e;
+	one.f = (REBU64)1 << -one.e;
+	integrals = (REBCNT)(too_hi.f >> -one.e);
+	fractionals = too_hi.f & (one.f - 1);
+
+	for (divisor = 1000000000, kappa = 10; divisor > integrals; divisor /= 10) kappa--;
+
+	*len = 0;
+	while (kappa > 0) {
+		buf[(*len)++] = (REBYTE)('0' + integrals / divisor);
+		integrals %= divisor;
+		kappa--;
+		rest = ((REBU64)integrals << -one.e) + fractionals;
+		if (rest < unsafe) {
+			*decpt = *len - mk + kappa;
+			return Round_Weed(buf, *len, too_hi.f - w.f, unsafe, rest, (REBU64)divisor << -one.e, unit);
+		}
+		divisor /= 10;
+	}
+
+	for (;;) {
+		fractionals *= 10;
+		unit *= 10;
+		unsafe *= 10;
+		buf[(*len)++] = (REBYTE)('0' + (fractionals >> -one.e));
+		fractionals &= one.f - 1;
+		kappa--;
+		if (fractionals < unsafe) {
+			*decpt = *len - mk + kappa;
+			return Round_Weed(buf, *len, (too_hi.f - w.f) * unit, unsafe, fractionals, one.f, unit);
+		}
+	}
+}
+
 REBINT Emit_Decimal(REBYTE *cp, REBDEC d, REBFLG trim, REBYTE point, REBINT decimal_digits) {
 	REBYTE *start = cp, *sig, *rve;
 	REBINT e, sgn, digits_obtained;
+	REBYTE digs[24];
 
 	/* sanity checks */
 	if (decimal_digits < MIN_DIGITS) decimal_digits = MIN_DIGITS;
 	else if (decimal_digits > MAX_DIGITS) decimal_digits = MAX_DIGITS;
 
-	sig = (REBYTE *) dtoa (d, 0, decimal_digits, &e, &sgn, (char **) &rve);
-
-	digits_obtained = rve - sig;
+	sgn = d < 0.0;
+	if (d != 0.0 && FINITE(d) && Grisu_Digits(sgn ? -d : d, digs, &digits_obtained, &e)) {
+		// Same as dtoa: no trailing zeros
+		while (digits_obtained > 1 && digs[digits_obtained - 1] == '0') digits_obtained--;
+		sig = digs;
+	}
+	else {
+		sig = (REBYTE *) dtoa (d, 0, decimal_digits, &e, &sgn, (char **) &rve);
+		digits_obtained = rve - sig;
+	}
 
 	/* handle sign */
 	if (sgn) *cp++ = '-';
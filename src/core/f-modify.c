@@ -123,6 +123,7 @@
 	REBINT size;		// total to insert
 
 	if (dups < 0) return (action == A_APPEND) ? 0 : dst_idx;
+	if (PG_UTF8_Indexes) Free_UTF8_Index(dst_ser);
 	if (action == A_APPEND || dst_idx > tail) dst_idx = tail;
 
 	// If the src_val is not a string, then we need to create a string:
@@ -30,6 +30,10 @@
 #include "sys-core.h"
 #include "sys-deci-funcs.h"
 
+#ifdef HAS_CPU_FEATURES
+#include <cpuid.h>
+#endif
+
 /***********************************************************************
 **
 */	void Long_To_Bytes(REBYTE *out, REBCNT in)
@@ -946,3 +950,37 @@
 	}
 	return 0;
 }
+
+
+/***********************************************************************
+**
+*/	REBCNT CPU_Features(void)
+/*
+**		Return the CPU_* flags for optional instructions that this
+**		processor supports. Detected once, on the first call.
+**
+***********************************************************************/
+{
+	static REBCNT features = 0;
+#ifdef HAS_CPU_FEATURES
+	unsigned int a, b, c, d;
+
+	if (features) return features;
+	features = CPU_CHECKED;
+
+	if (!__get_cpuid(1, &a, &b, &c, &d)) return features;
+	if (!(c & bit_SSSE3)) return features;
+	features |= CPU_SSSE3;
+	if (!(c & bit_SSE4_1)) return features;
+	if (c & bit_PCLMUL) features |= CPU_PCLMUL;
+
+	if (__get_cpuid_max(0, 0) >= 7) {
+		__cpuid_count(7, 0, a, b, c, d);
+		if (b & (1 << 29)) features |= CPU_SHA; // bit_SHA
+	}
+#else
+	features = CPU_CHECKED;
+#endif
+	return features;
+}
+
@@ -298,7 +298,10 @@ mark_obj:
 			break;
 
 		case REB_VECTOR:
-			MARK_SERIES(VAL_SERIES(val));
+			ser = VAL_SERIES(val);
+			MARK_SERIES(ser);
+			// A vector view keeps the series it views:
+			if (IS_EXT_SERIES(ser) && NZ(ser = View_Target(ser))) MARK_SERIES(ser);
 			break;
 
 		case REB_BLOCK:
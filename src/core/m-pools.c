@@ -55,6 +55,24 @@
 
 #define	BAD_MEM_PTR ((REBYTE *)0xBAD1BAD1)
 
+// Series whose data is a mapped file (unmapped when the series is freed):
+typedef struct rebol_mapping {
+	struct rebol_mapping *next;
+	REBSER *series;
+	REBYTE *data;	// original address (series data may be biased)
+	REBCNT len;
+} REBMAP;
+
+static REBMAP *Mappings;
+
+// Series whose data is in another series (see Make_View_Series).
+// The view and its target both point to this record (series->view):
+typedef struct rebol_view {
+	struct rebol_view *next;	// next view of the same target
+	REBSER *series;	// the view
+	REBSER *target;	// series that has the data (zero if freed)
+} REBVIEW;
+
 //#define GC_TRIGGER (GC_Active && (GC_Ballast <= 0 || (GC_Pending && !GC_Disabled)))
 
 #ifdef POOL_MAP
@@ -420,6 +438,7 @@ const REBPOOLSPEC Mem_Pool_Spec[MAX_POOLS] =
 	memset((REBYTE *)node, 0xff, length);
 #endif
 	series->tail = series->size = 0;
+	series->view = 0;
 	SERIES_REST(series) = length / wide;
 	series->data = (REBYTE *)node;
 	series->info = wide; // also clears flags
@@ -437,6 +456,195 @@ const REBPOOLSPEC Mem_Pool_Spec[MAX_POOLS] =
 }
 
 
+/***********************************************************************
+**
+*/	REBSER *Make_Ext_Series(REBYTE *data, REBCNT length, REBCNT wide)
+/*
+**		Make a series header for data that was not allocated here,
+**		such as a view into the data of another series. The header
+**		is collected as usual, but the data is never freed by it.
+**
+***********************************************************************/
+{
+	REBSER *series;
+
+	PG_Reb_Stats->Series_Made++;
+
+	series = (REBSER *)Make_Node(SERIES_POOL);
+	series->tail = length;
+	series->size = 0;
+	series->view = 0;
+	SERIES_REST(series) = length;
+	series->data = data;
+	series->info = wide; // also clears flags
+	SERIES_SET_FLAG(series, SER_EXT);
+	LABEL_SERIES(series, "external");
+
+	// Keep the last few series in the nursery, safe from GC:
+	if (GC_Last_Infant >= MAX_SAFE_SERIES) GC_Last_Infant = 0;
+	GC_Infants[GC_Last_Infant++] = series;
+
+	return series;
+}
+
+
+/***********************************************************************
+**
+*/	REBSER *Make_Map_Series(REBYTE *data, REBCNT len)
+/*
+**		Make a binary series for a file mapped by OS_Map_File.
+**		The map has a writable byte for the terminator, but it
+**		can not grow, so the series is locked. The map is released
+**		when the series is freed.
+**
+***********************************************************************/
+{
+	REBSER *series = Make_Ext_Series(data, len, 1);
+	REBMAP *map = Make_Mem(sizeof(REBMAP));
+
+	SERIES_REST(series) = len + 1;
+	LOCK_SERIES(series);
+	LABEL_SERIES(series, "mapped file");
+
+	map->series = series;
+	map->data = data;
+	map->len = len;
+	map->next = Mappings;
+	Mappings = map;
+
+	return series;
+}
+
+
+/***********************************************************************
+**
+*/	REBSER *Make_View_Series(REBSER *target, REBCNT offset, REBCNT len, REBCNT wide)
+/*
+**		Make a series that uses the data of another series (from
+**		a byte offset) without copying it. The view keeps the
+**		target from being collected (see View_Target). If the
+**		target data is reallocated, the view gets a copy of its
+**		data first (see Detach_Views).
+**
+**		An external target (a mapped file) never moves, so it does
+**		not keep a list of its views.
+**
+***********************************************************************/
+{
+	REBSER *series = Make_Ext_Series(target->data + offset, len, wide);
+	REBVIEW *view = Make_Mem(sizeof(REBVIEW));
+
+	LABEL_SERIES(series, "view");
+
+	view->series = series;
+	view->target = target;
+	view->next = 0;
+	series->view = view;
+	if (!IS_EXT_SERIES(target)) {
+		view->next = target->view;
+		target->view = view;
+	}
+
+	return series;
+}
+
+
+/***********************************************************************
+**
+*/	REBSER *View_Target(REBSER *series)
+/*
+**		Return the series that a view uses the data of, or zero if
+**		it is not a view. Used by the GC to mark the target.
+**
+***********************************************************************/
+{
+	if (!IS_EXT_SERIES(series) || !series->view) return 0;
+	return series->view->target;
+}
+
+
+/***********************************************************************
+**
+*/	void Detach_Views(REBSER *target)
+/*
+**		Give the views of a series their own copy of its data.
+**		Called before the series data is reallocated or freed.
+**		A detached view is a normal series.
+**
+***********************************************************************/
+{
+	REBVIEW *view;
+	REBSER *series;
+	REBYTE *data;
+	REBCNT tail;
+	REBCNT wide;
+
+	if (IS_EXT_SERIES(target)) return;
+
+	while (NZ(view = target->view)) {
+		target->view = view->next;
+
+		series = view->series;
+		data = series->data;
+		tail = series->tail;
+		wide = SERIES_WIDE(series);
+		Make_Series_Data(series, tail + 1); // (does not recycle)
+		memcpy(series->data, data, tail * wide);
+		series->tail = tail;
+		CLEAR(series->data + tail * wide, wide); // terminate
+		SERIES_CLR_FLAG(series, SER_EXT | SER_LOCK);
+		series->view = 0;
+
+		Free_Mem(view, sizeof(REBVIEW));
+	}
+}
+
+
+/***********************************************************************
+**
+*/	static void Free_View(REBSER *series)
+/*
+**		Forget a view that is being freed.
+**
+***********************************************************************/
+{
+	REBVIEW *view = series->view;
+	REBVIEW **prior;
+
+	series->view = 0;
+
+	// Unlink it from its target, unless the target went first:
+	if (view->target && !IS_EXT_SERIES(view->target)) {
+		for (prior = &view->target->view; *prior != view; prior = &(*prior)->next);
+		*prior = view->next;
+	}
+
+	Free_Mem(view, sizeof(REBVIEW));
+}
+
+
+/***********************************************************************
+**
+*/	static void Free_Mapping(REBSER *series)
+/*
+**		Release the file map of an external series, if it has one.
+**
+***********************************************************************/
+{
+	REBMAP **prior;
+	REBMAP *map;
+
+	for (prior = &Mappings; NZ(map = *prior); prior = &map->next) {
+		if (map->series == series) {
+			*prior = map->next;
+			OS_UNMAP_FILE(map->data, map->len);
+			Free_Mem(map, sizeof(REBMAP));
+			return;
+		}
+	}
+}
+
+
 /***********************************************************************
 **
 */	void Free_Series_Data(REBSER *series, REBOOL protect)
@@ -454,7 +662,17 @@ const REBPOOLSPEC Mem_Pool_Spec[MAX_POOLS] =
 	// !!!! Dump_Series(series, "Free-Data");
 
 	if (SERIES_FREED(series) || series->data == BAD_MEM_PTR) return; // No free twice.
-	if (IS_EXT_SERIES(series)) goto clear_header;  // Must be library related
+	if (PG_UTF8_Indexes) Free_UTF8_Index(series);
+
+	if (IS_EXT_SERIES(series)) {  // Must be library related
+		if (Mappings) Free_Mapping(series);
+		if (series->view) Free_View(series);
+		goto clear_header;
+	}
+
+	// Views that are freed in the same sweep must not unlink later:
+	for (; series->view; series->view = series->view->next)
+		series->view->target = 0;
 
 	size = SERIES_TOTAL(series);
 	if ((GC_Ballast += size) > VAL_INT32(TASK_BALLAST))
@@ -91,7 +91,12 @@
 	// Do we need to expand the current series allocation?
 	// WARNING: Do not use ">=" below or newser size may be the same!
 	if ((size + extra) > SERIES_SPACE(series)) {
-		if (IS_LOCK_SERIES(series)) Crash(RP_LOCKED_SERIES);
+		if (IS_LOCK_SERIES(series)) {
+			// Mapped files and views are locked (user error):
+			if (!IS_BLOCK_SERIES(series)) Trap0(RE_LOCKED_SERIES);
+			Crash(RP_LOCKED_SERIES);
+		}
+		Detach_Views(series); // (before the data moves)
 		//DISABLE_GC; // Don't let GC occur just for an expansion.
 
 		if (Reb_Opts->watch_expand) {
@@ -330,6 +335,7 @@
 	REBYTE	*data;
 
 	if (len <= 0) return;
+	if (PG_UTF8_Indexes) Free_UTF8_Index(series);
 
 	// Optimized case of head removal:
 	if (index == 0) {
@@ -411,6 +417,25 @@
 }
 
 
+/***********************************************************************
+**
+*/	void Narrow_Series(REBSER *series)
+/*
+**		Make an empty unicode series hold bytes, in the same memory.
+**		The bias is reset and the rest doubled (twice as many units
+**		fit). Used to return a widened string buffer to byte size.
+**
+***********************************************************************/
+{
+	ASSERT(SERIES_WIDE(series) == sizeof(REBUNI) && !series->tail, RP_BAD_WIDTH);
+
+	if (SERIES_BIAS(series)) Reset_Bias(series);
+	SERIES_REST(series) *= sizeof(REBUNI);
+	SERIES_FLAGS(series) = (SERIES_FLAGS(series) & ~0xff) | 1;
+	TERM_SERIES(series);
+}
+
+
 /***********************************************************************
 **
 */	void Reset_Series(REBSER *series)
@@ -484,6 +509,7 @@
 {
 	if (SERIES_REST(series) <= units) return;
 	//DISABLE_GC;
+	Detach_Views(series);
 	Free_Series_Data(series, FALSE);
 	Make_Series_Data(series, units);
 	//ENABLE_GC;
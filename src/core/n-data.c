@@ -209,6 +209,19 @@ static int Check_Char_Range(REBVAL *val, REBINT limit)
 }
 
 
+/***********************************************************************
+**
+*/	REBNATIVE(as_vector)
+/*
+***********************************************************************/
+{
+	REBINT len = D_REF(3) ? Int32s(D_ARG(4), 0) : -1;
+
+	if (!Make_Vector_View(D_RET, D_ARG(1), D_ARG(2), len)) Trap_Arg(D_ARG(2));
+	return R_RET;
+}
+
+
 /***********************************************************************
 **
 */	REBNATIVE(as_pair)
@@ -130,6 +130,7 @@ static REBSER *Read_All_File(char *fname)
 	REBVAL *val = D_ARG(1);
 	REB_MOLD mo = {0};
 
+	SET_FLAG(mo.opts, MOPT_BYTES);
 	if (D_REF(3)) SET_FLAG(mo.opts, MOPT_MOLD_ALL);
 	if (D_REF(4)) SET_FLAG(mo.opts, MOPT_INDENT);
 
@@ -274,6 +274,50 @@ enum {SINE, COSINE, TANGENT};
 }
 
 
+/***********************************************************************
+**
+*/	REBNATIVE(vector_sum)
+/*
+***********************************************************************/
+{
+	Sum_Vector(D_ARG(1), D_RET);
+	return R_RET;
+}
+
+
+/***********************************************************************
+**
+*/	REBNATIVE(vector_min)
+/*
+***********************************************************************/
+{
+	Limit_Vector(D_ARG(1), FALSE, D_RET);
+	return R_RET;
+}
+
+
+/***********************************************************************
+**
+*/	REBNATIVE(vector_max)
+/*
+***********************************************************************/
+{
+	Limit_Vector(D_ARG(1), TRUE, D_RET);
+	return R_RET;
+}
+
+
+/***********************************************************************
+**
+*/	REBNATIVE(vector_dot)
+/*
+***********************************************************************/
+{
+	Dot_Vector(D_ARG(1), D_ARG(2), D_RET);
+	return R_RET;
+}
+
+
 /***********************************************************************
 **
 */	REBINT Compare_Values(REBVAL *a, REBVAL *b, REBINT strictness)
@@ -494,6 +538,9 @@ compare:
 	if (IS_PAIR(D_ARG(1)) || IS_PAIR(D_ARG(2)))
 		return Min_Max_Pair(ds, 1);
 
+	if (IS_VECTOR(D_ARG(1)) || IS_VECTOR(D_ARG(2)))
+		return Min_Max_Vector(ds, 1);
+
 	a = *D_ARG(1);
 	b = *D_ARG(2);
 	if (Compare_Values(&a, &b, -1)) return R_ARG1;
@@ -511,6 +558,9 @@ compare:
 	if (IS_PAIR(D_ARG(1)) || IS_PAIR(D_ARG(2)))
 		return Min_Max_Pair(ds, 0);
 
+	if (IS_VECTOR(D_ARG(1)) || IS_VECTOR(D_ARG(2)))
+		return Min_Max_Vector(ds, 0);
+
 	a = *D_ARG(1);
 	b = *D_ARG(2);
 	if (Compare_Values(&a, &b, -1)) return R_ARG2;
@@ -57,6 +57,14 @@ int  MD5_CtxSize(void);
 #endif
 #endif
 
+#ifdef HAS_SHA256
+REBYTE *SHA256(REBYTE *, REBCNT, REBYTE *);
+void SHA256_Init(void *c);
+void SHA256_Update(void *c, REBYTE *data, REBCNT len);
+void SHA256_Final(REBYTE *md, void *c);
+int  SHA256_CtxSize(void);
+#endif
+
 #ifdef HAS_MD4
 REBYTE *MD4(REBYTE *, REBCNT, REBYTE *);
 void MD4_Init(void *c);
@@ -66,21 +74,16 @@ int  MD4_CtxSize(void);
 #endif
 
 // Table of has functions and parameters:
-static struct digest {
-	REBYTE *(*digest)(REBYTE *, REBCNT, REBYTE *);
-	void (*init)(void *);
-	void (*update)(void *, REBYTE *, REBCNT);
-	void (*final)(REBYTE *, void *);
-	int (*ctxsize)(void);
-	REBINT index;
-	REBINT len;
-	REBINT hmacblock;
-} digests[] = {
+static REB_DIGEST digests[] = {
 
 #ifdef HAS_SHA1
 	{SHA1, SHA1_Init, SHA1_Update, SHA1_Final, SHA1_CtxSize, SYM_SHA1, 20, 64},
 #endif
 
+#ifdef HAS_SHA256
+	{SHA256, SHA256_Init, SHA256_Update, SHA256_Final, SHA256_CtxSize, SYM_SHA256, 32, 64},
+#endif
+
 #ifdef HAS_MD4
 	{MD4, MD4_Init, MD4_Update, MD4_Final, MD4_CtxSize, SYM_MD4, 16, 64},
 #endif
@@ -94,6 +97,23 @@ static struct digest {
 };
 
 
+/***********************************************************************
+**
+*/	REB_DIGEST *Find_Digest(REBINT sym)
+/*
+**		Return the digest method for a checksum word, or zero.
+**
+***********************************************************************/
+{
+	REB_DIGEST *dig;
+
+	for (dig = digests; dig->digest; dig++) {
+		if (dig->index == sym) return dig;
+	}
+	return 0;
+}
+
+
 /***********************************************************************
 **
 */	REBNATIVE(ajoin)
@@ -153,7 +173,7 @@ static struct digest {
 **		/hash {Returns a hash value}
 **		size [integer!] {Size of the hash table}
 **		/method {Method to use}
-**		word [word!] {Method: SHA1 MD5}
+**		word [word!] {Method: SHA1 SHA256 MD5}
 **		/key {Returns keyed HMAC value}
 **		key-value [any-string!] {Key to use}
 **
@@ -197,7 +217,7 @@ static struct digest {
 				LABEL_SERIES(digest, "checksum digest");
 
 				if (D_REF(ARG_CHECKSUM_KEY)) {
-					REBYTE tmpdigest[20];		// Size must be max of all digest[].len;
+					REBYTE tmpdigest[32];		// Size must be max of all digest[].len;
 					REBYTE ipad[64],opad[64];	// Size must be max of all digest[].hmacblock;
 					void *ctx = Make_Mem(digests[i].ctxsize());
 					REBVAL *key = D_ARG(ARG_CHECKSUM_KEY_VALUE);
@@ -274,12 +294,15 @@ static struct digest {
 	REBSER *ser;
 	REBCNT index;
 	REBINT len;
+	REBCNT threads = 1;
 
 	len = Partial1(D_ARG(1), D_ARG(3));
 
+	if (D_REF(5)) threads = Int32s(D_ARG(6), 0); // /threads count
+
 	ser = Prep_Bin_Str(D_ARG(1), &index, &len); // result may be a SHARED BUFFER!
 
-	Set_Binary(D_RET, Compress(ser, index, len, D_REF(4))); // /gzip
+	Set_Binary(D_RET, Compress(ser, index, len, D_REF(4), threads)); // /gzip
 
 	return R_RET;
 }
@@ -417,6 +440,7 @@ static struct digest {
 	REBVAL *data = D_ARG(1);
 	REBVAL *key  = D_ARG(2);
 
+	if (PG_UTF8_Indexes) Free_UTF8_Index(VAL_SERIES(data));
 	if (!Cloak(TRUE, VAL_BIN_DATA(data), VAL_LEN(data), (REBYTE*)key, 0, D_REF(3)))
 		Trap_Arg(key);
 
@@ -435,6 +459,7 @@ static struct digest {
 	REBVAL *data = D_ARG(1);
 	REBVAL *key  = D_ARG(2);
 
+	if (PG_UTF8_Indexes) Free_UTF8_Index(VAL_SERIES(data));
 	if (!Cloak(FALSE, VAL_BIN_DATA(data), VAL_LEN(data), (REBYTE*)key, 0, D_REF(3)))
 		Trap_Arg(key);
 
@@ -749,3 +774,53 @@ static struct digest {
 	VAL_INDEX(arg) = bp - VAL_BIN_HEAD(arg);
 	return R_ARG1;
 }
+
+
+/***********************************************************************
+**
+*/	REBNATIVE(utf8_lengthq)
+/*
+***********************************************************************/
+{
+	REBINT n = Length_UTF8_Chars(VAL_BIN_DATA(D_ARG(1)), VAL_LEN(D_ARG(1)));
+	DS_RET_INT(n);
+	return R_RET;
+}
+
+
+/***********************************************************************
+**
+*/	REBNATIVE(utf8_at)
+/*
+**		The index table made for long seeks is kept with the binary
+**		(see Seek_UTF8), so repeated calls on the same data do not
+**		scan it again.
+**
+***********************************************************************/
+{
+	REBVAL *arg = D_ARG(1);
+	REBVAL *val = D_ARG(2);
+	REBSER *blk;
+	REBVAL *out;
+
+	if (IS_INTEGER(val)) {
+		VAL_INDEX(arg) = Seek_UTF8(VAL_SERIES(arg), VAL_INDEX(arg), Int32s(val, 0));
+		return R_ARG1;
+	}
+
+	for (out = VAL_BLK_DATA(val); NOT_END(out); out++) {
+		if (!IS_INTEGER(out)) Trap_Arg(out);
+		Int32s(out, 0); // check range and sign
+	}
+
+	blk = Make_Block(VAL_LEN(val));
+	Set_Block(D_RET, blk); // Keep safe
+
+	for (val = VAL_BLK_DATA(val); NOT_END(val); val++) {
+		out = Append_Value(blk);
+		*out = *arg;
+		VAL_INDEX(out) = Seek_UTF8(VAL_SERIES(arg), VAL_INDEX(arg), Int32s(val, 0));
+	}
+
+	return R_RET;
+}
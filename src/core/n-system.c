@@ -378,6 +378,155 @@ err:
 }
 
 
+typedef struct reb_codec_rows {
+	REBCDI codi;		// first, so the rows callback can find the rest
+	REBVAL *out;		// result image
+	REBSER *img;
+	REBINT scale;		// reduction left to do after the codec's own
+	REBINT part[4];		// region wanted (x, y, w, h) in source pixels
+	REBINT x, y, w, h;	// region in the rows the codec delivers
+	REBCNT *sums;		// channel sums for one output row
+	REBFLG too_big;
+} REBCRS;
+
+
+/***********************************************************************
+**
+*/	static REBFLG Begin_Codec_Rows(REBCRS *crs)
+/*
+**		Called with the first rows, once the codec has set w and h.
+**		Maps the region into delivered rows and makes the image.
+**
+***********************************************************************/
+{
+	REBCDI *codi = &crs->codi;
+	REBINT n = MAX(codi->scaled, 1);
+	REBINT s = crs->scale = MAX(codi->scale / n, 1);
+	REBINT w, h;
+
+	crs->x = MIN(crs->part[0] / n, codi->w);
+	crs->y = MIN(crs->part[1] / n, codi->h);
+	crs->w = (REBINT)MIN(((REBI64)crs->part[2] + n - 1) / n, codi->w - crs->x);
+	crs->h = (REBINT)MIN(((REBI64)crs->part[3] + n - 1) / n, codi->h - crs->y);
+
+	w = (crs->w + s - 1) / s;
+	h = (crs->h + s - 1) / s;
+	crs->img = Make_Image(w, h, FALSE);
+	if (!crs->img) {
+		crs->too_big = TRUE;
+		return FALSE;
+	}
+	SET_IMAGE(crs->out, crs->img);
+	if (s > 1) crs->sums = Make_Mem(w * 4 * sizeof(REBCNT));
+	return TRUE;
+}
+
+
+/***********************************************************************
+**
+*/	static void Flush_Codec_Row(REBCRS *crs, REBINT row, REBINT rows)
+/*
+**		Store the averages of the summed rows as an image row.
+**
+***********************************************************************/
+{
+	REBINT w = IMG_WIDE(crs->img);
+	REBYTE *dp = IMG_DATA(crs->img) + row * w * 4;
+	REBCNT *sp = crs->sums;
+	REBINT cols = crs->scale;
+	REBCNT n;
+	REBINT i, c;
+
+	for (i = 0; i < w; i++, dp += 4, sp += 4) {
+		if (i == w - 1) cols = crs->w - i * crs->scale;
+		n = cols * rows;
+		for (c = 0; c < 4; c++) dp[c] = (REBYTE)((sp[c] + n / 2) / n);
+	}
+	CLEAR(crs->sums, w * 4 * sizeof(REBCNT));
+}
+
+
+/***********************************************************************
+**
+*/	static int Codec_Rows(REBCDI *codi, int y, int count, unsigned int *bits)
+/*
+**		Rows callback for CODI_DECODE_ROWS. Crops to the region and
+**		box filters the rows down by what is left of the scale.
+**		Returns non-zero to stop the codec past the region.
+**
+***********************************************************************/
+{
+	REBCRS *crs = (REBCRS *)codi;
+	REBINT s;
+	REBINT n, i, k;
+	REBYTE *bp;
+	REBCNT *sp;
+
+	if (!crs->img && !Begin_Codec_Rows(crs)) return 1;
+	s = crs->scale;
+
+	for (; count > 0; count--, y++, bits += codi->w) {
+		if (y < crs->y) continue;
+		if (y >= crs->y + crs->h) return 1;
+		n = y - crs->y;
+
+		if (s == 1) {
+			memcpy(IMG_DATA(crs->img) + n * crs->w * 4, bits + crs->x, crs->w * 4);
+			continue;
+		}
+
+		bp = (REBYTE *)(bits + crs->x);
+		sp = crs->sums;
+		for (i = 0, k = s; i < crs->w; i++, bp += 4) {
+			sp[0] += bp[0];
+			sp[1] += bp[1];
+			sp[2] += bp[2];
+			sp[3] += bp[3];
+			if (--k == 0) {
+				sp += 4;
+				k = s;
+			}
+		}
+		if ((n + 1) % s == 0 || n + 1 == crs->h)
+			Flush_Codec_Row(crs, n / s, n % s + 1);
+	}
+
+	return 0;
+}
+
+
+/***********************************************************************
+**
+*/	static void Decode_Codec_Rows(REBVAL *ds, REBCRS *crs)
+/*
+**		Decode an image with CODI_DECODE_ROWS, so that only the
+**		reduced (or cropped) image is ever held in memory.
+**
+***********************************************************************/
+{
+	REBCDI *codi = &crs->codi;
+	REBINT result;
+
+	codi->action = CODI_DECODE_ROWS;
+	codi->scaled = 1;
+	codi->rows = Codec_Rows;
+	crs->out = D_RET;
+
+	result = ((codo) (VAL_HANDLE(D_ARG(1))))(codi);
+
+	// A codec that could not stream returns the whole bitmap:
+	if (result == CODI_IMAGE && codi->error == 0 && codi->bits) {
+		Codec_Rows(codi, 0, codi->h, codi->bits);
+		Free_Mem(codi->bits, codi->w * codi->h * 4);
+	}
+
+	if (crs->sums) Free_Mem(crs->sums, IMG_WIDE(crs->img) * 4 * sizeof(REBCNT));
+
+	if (crs->too_big) Trap1(RE_SIZE_LIMIT, Get_Type(REB_IMAGE));
+	if (codi->error != 0 || result != CODI_IMAGE || !crs->img) Trap0(RE_BAD_MEDIA);
+}
+
+
 /***********************************************************************
 **
 */	REBNATIVE(do_codec)
@@ -388,11 +537,16 @@ err:
 **		1: codec:  handle!
 **		2: action: word! (identify, decode, encode)
 **		3: data:   binary! image! sound!
-**		4: option: (optional)
+**		4: /scale
+**		5: factor: integer!
+**		6: /part
+**		7: offset: pair!
+**		8: size:   pair!
 **
 ***********************************************************************/
 {
 	REBCDI codi;
+	REBCRS crs;
 	REBVAL *val;
 	REBINT result;
 	REBSER *ser;
@@ -411,6 +565,25 @@ err:
 		if (!IS_BINARY(val)) Trap1(RE_INVALID_ARG, val);
 		codi.data = VAL_BIN_DATA(D_ARG(3));
 		codi.len  = VAL_LEN(D_ARG(3));
+		if (codi.action == CODI_DECODE && (D_REF(4) || D_REF(6))) {
+			CLEAR(&crs, sizeof(crs));
+			crs.codi = codi;
+			crs.codi.scale = 1;
+			crs.part[2] = crs.part[3] = MAX_I32;
+			if (D_REF(4)) {
+				// (sums of scale * scale pixels must fit 32 bits)
+				crs.codi.scale = Int32s(D_ARG(5), 1);
+				if (crs.codi.scale > 4096) Trap_Range(D_ARG(5));
+			}
+			if (D_REF(6)) {
+				crs.part[0] = MAX((REBINT)VAL_PAIR_X(D_ARG(7)), 0);
+				crs.part[1] = MAX((REBINT)VAL_PAIR_Y(D_ARG(7)), 0);
+				crs.part[2] = MAX((REBINT)VAL_PAIR_X(D_ARG(8)), 0);
+				crs.part[3] = MAX((REBINT)VAL_PAIR_Y(D_ARG(8)), 0);
+			}
+			Decode_Codec_Rows(ds, &crs);
+			return R_RET;
+		}
 		break;
 
 	case SYM_ENCODE:
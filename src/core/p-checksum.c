@@ -0,0 +1,230 @@
+/***********************************************************************
+**
+**  REBOL [R3] Language Interpreter and Run-time Environment
+**
+**  Copyright 2012 REBOL Technologies
+**  REBOL is a trademark of REBOL Technologies
+**
+**  Licensed under the Apache License, Version 2.0 (the "License");
+**  you may not use this file except in compliance with the License.
+**  You may obtain a copy of the License at
+**
+**  http://www.apache.org/licenses/LICENSE-2.0
+**
+**  Unless required by applicable law or agreed to in writing, software
+**  distributed under the License is distributed on an "AS IS" BASIS,
+**  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**  See the License for the specific language governing permissions and
+**  limitations under the License.
+**
+************************************************************************
+**
+**  Module:  p-checksum.c
+**  Summary: incremental checksum port interface
+**  Section: ports
+**  Notes:
+**
+***********************************************************************/
+/*
+	Computes a checksum over data written in chunks, so large
+	files and network streams can be hashed in fixed memory:
+
+	sum: open checksum:md5		; or: open [scheme: 'checksum method: 'md5]
+	while [not empty? data: read/part file 65536] [write sum data]
+	read sum		; digest so far (more data can still be written)
+	length? sum		; bytes written
+	clear sum		; start over
+	close sum
+
+	Methods are those of CHECKSUM/method. SHA1, SHA256, MD5 (and MD4)
+	return a binary; CRC32 and ADLER32 return an integer.
+*/
+
+#include "sys-core.h"
+
+typedef struct rebol_checksum_state {
+	REB_DIGEST *digest;	// zero for CRC32 and ADLER32
+	REBINT method;		// method symbol
+	REBCNT sum;			// running CRC32 or ADLER32 value
+	REBI64 length;		// bytes written
+	REBU64 ctx[1];		// digest context (extends past the struct)
+} REBCHK;
+
+
+/***********************************************************************
+**
+*/	static void Reset_Checksum(REBCHK *chk)
+/*
+***********************************************************************/
+{
+	chk->length = 0;
+	if (chk->digest) chk->digest->init(chk->ctx);
+	else chk->sum = (chk->method == SYM_ADLER32) ? 1 : 0;
+}
+
+
+/***********************************************************************
+**
+*/	static REBCHK *Open_Checksum(REBSER *port)
+/*
+**		Create the port state for the method given in the spec.
+**
+***********************************************************************/
+{
+	REBVAL *state = BLK_SKIP(port, STD_PORT_STATE);
+	REBVAL *method = Obj_Value(BLK_SKIP(port, STD_PORT_SPEC), STD_PORT_SPEC_CHECKSUM_METHOD);
+	REB_DIGEST *dig = 0;
+	REBINT sym = SYM_SHA1;
+	REBCNT size = sizeof(REBCHK);
+	REBSER *ser;
+	REBCHK *chk;
+
+	if (method && !IS_NONE(method)) {
+		if (!IS_WORD(method)) Trap1(RE_INVALID_SPEC, method);
+		sym = VAL_WORD_CANON(method);
+	}
+
+	if (sym != SYM_CRC32 && sym != SYM_ADLER32) {
+		dig = Find_Digest(sym);
+		if (!dig) Trap1(RE_INVALID_SPEC, method);
+		size += dig->ctxsize();
+	}
+
+	ser = Make_Binary(size);
+	CLEAR(BIN_HEAD(ser), size);
+	Set_Binary(state, ser);
+
+	chk = (REBCHK *)BIN_HEAD(ser);
+	chk->digest = dig;
+	chk->method = sym;
+	Reset_Checksum(chk);
+
+	return chk;
+}
+
+
+/***********************************************************************
+**
+*/	static void Update_Checksum(REBCHK *chk, REBYTE *data, REBCNT len)
+/*
+***********************************************************************/
+{
+	if (chk->digest) chk->digest->update(chk->ctx, data, len);
+	else if (chk->method == SYM_CRC32) chk->sum = Update_CRC32(chk->sum, data, len);
+	else chk->sum = Update_ADLER32(chk->sum, data, len);
+	chk->length += len;
+}
+
+
+/***********************************************************************
+**
+*/	static void Final_Checksum(REBCHK *chk, REBVAL *out)
+/*
+**		Finish a copy of the context, so that writing can continue.
+**
+***********************************************************************/
+{
+	REB_DIGEST *dig = chk->digest;
+	REBSER *ser;
+	void *ctx;
+
+	if (!dig) {
+		SET_INTEGER(out, (REBINT)chk->sum);
+		return;
+	}
+
+	ser = Make_Binary(dig->len);
+	ctx = Make_Mem(dig->ctxsize());
+	memcpy(ctx, chk->ctx, dig->ctxsize());
+	dig->final(BIN_HEAD(ser), ctx);
+	Free_Mem(ctx, dig->ctxsize());
+
+	SERIES_TAIL(ser) = dig->len;
+	Set_Binary(out, ser);
+}
+
+
+/***********************************************************************
+**
+*/	static int Checksum_Actor(REBVAL *ds, REBSER *port, REBCNT action)
+/*
+***********************************************************************/
+{
+	REBVAL *state;
+	REBVAL *arg;
+	REBCHK *chk = 0;
+	REBSER *ser;
+	REBCNT refs;
+	REBCNT len;
+
+	Validate_Port(port, action);
+
+	arg = D_ARG(2);
+	state = BLK_SKIP(port, STD_PORT_STATE);
+	if (IS_BINARY(state)) chk = (REBCHK *)VAL_BIN(state);
+
+	switch (action) {
+
+	case A_WRITE:
+		if (!IS_STRING(arg) && !IS_BINARY(arg)) Trap1(RE_INVALID_PORT_ARG, arg);
+		if (!chk) chk = Open_Checksum(port);
+
+		refs = Find_Refines(ds, ALL_WRITE_REFS);
+		len = VAL_LEN(arg);
+		if (refs & AM_WRITE_PART) {
+			REBCNT n = Int32s(D_ARG(ARG_WRITE_LENGTH), 0);
+			if (n <= len) len = n;
+		}
+
+		// Strings are checksummed as UTF-8:
+		if (IS_STRING(arg) && (ser = Encode_UTF8_Value(arg, len, ENCF_NO_COPY)))
+			Update_Checksum(chk, BIN_HEAD(ser), SERIES_TAIL(ser));
+		else
+			Update_Checksum(chk, VAL_BIN_DATA(arg), len);
+		break;
+
+	case A_READ:
+	case A_QUERY:
+		if (!chk) Trap_Port(RE_NOT_OPEN, port, 0);
+		Final_Checksum(chk, D_RET);
+		return R_RET;
+
+	case A_LENGTHQ:
+		if (!chk) Trap_Port(RE_NOT_OPEN, port, 0);
+		SET_INTEGER(D_RET, chk->length);
+		return R_RET;
+
+	case A_CLEAR:
+		if (!chk) Trap_Port(RE_NOT_OPEN, port, 0);
+		Reset_Checksum(chk);
+		break;
+
+	case A_OPEN:
+		if (chk) Trap_Port(RE_ALREADY_OPEN, port, 0);
+		Open_Checksum(port);
+		break;
+
+	case A_CLOSE:
+		Free_Port_State(port);
+		break;
+
+	case A_OPENQ:
+		if (chk) return R_TRUE;
+		return R_FALSE;
+
+	default:
+		Trap_Action(REB_PORT, action);
+	}
+
+	return R_ARG1; // port
+}
+
+
+/***********************************************************************
+**
+*/	void Init_Checksum_Scheme(void)
+/*
+***********************************************************************/
+{
+	Register_Scheme(SYM_CHECKSUM, 0, Checksum_Actor);
+}
@@ -0,0 +1,584 @@
+/***********************************************************************
+**
+**  REBOL [R3] Language Interpreter and Run-time Environment
+**
+**  Copyright 2012 REBOL Technologies
+**  REBOL is a trademark of REBOL Technologies
+**
+**  Licensed under the Apache License, Version 2.0 (the "License");
+**  you may not use this file except in compliance with the License.
+**  You may obtain a copy of the License at
+**
+**  http://www.apache.org/licenses/LICENSE-2.0
+**
+**  Unless required by applicable law or agreed to in writing, software
+**  distributed under the License is distributed on an "AS IS" BASIS,
+**  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**  See the License for the specific language governing permissions and
+**  limitations under the License.
+**
+************************************************************************
+**
+**  Module:  p-compress.c
+**  Summary: streaming deflate and inflate port interface
+**  Section: ports
+**  Notes:
+**
+***********************************************************************/
+/*
+	Compresses or decompresses data written in chunks, so large
+	files and network streams never need to be in memory whole:
+
+	z: open deflate:gzip	; or: open [scheme: 'deflate format: 'gzip level: 9]
+	write z data			; as many times as needed
+	update z				; end of input (writes the trailer)
+	read z					; output so far (taken from the port)
+	close z
+
+	Formats are ZLIB (default), GZIP and RAW (deflate data only).
+	Level is 0 to 9, or none for the zlib default. Writing after
+	UPDATE starts a new stream.
+
+	With a target port in the spec, output is written to it as it
+	is produced, so stages can be chained over files and TCP:
+
+	out: open/new %log.gz
+	z: open [scheme: 'deflate format: 'gzip target: out]
+	write z data ...
+	close z					; finishes the stream into out
+	close out
+
+	An inflate port works the same way in reverse. TAIL? is true once
+	the end of the compressed stream is reached. Concatenated gzip
+	members are decompressed as one stream.
+*/
+
+#include "sys-core.h"
+#include "sys-zlib.h"
+
+#define ZCHUNK	16384		// output expansion step
+
+// Gzip header flags:
+#define GZ_FHCRC	0x02
+#define GZ_FEXTRA	0x04
+#define GZ_FNAME	0x08
+#define GZ_FCOMMENT	0x10
+
+// Stream progress:
+enum {
+	ZS_HEAD,		// gzip header (to write or parse)
+	ZS_SKIP,		// skipping gzip header bytes
+	ZS_EXTRA_LEN,	// gzip extra field length
+	ZS_NAME,		// gzip file name (zero terminated)
+	ZS_COMMENT,		// gzip comment (zero terminated)
+	ZS_BODY,		// compressed data
+	ZS_TAIL,		// gzip trailer (CRC32 and size)
+	ZS_DONE			// end of stream
+};
+
+typedef struct rebol_zstream_state {
+	z_stream strm;
+	REBFLG deflate;		// TRUE to compress
+	REBINT format;		// SYM_ZLIB, SYM_GZIP or SYM_RAW
+	REBINT mode;		// stream progress (ZS_*)
+	REBCNT crc;			// gzip CRC32 of uncompressed data
+	REBCNT size;		// gzip uncompressed size (modulo 2^32)
+	REBCNT flags;		// gzip header flags not yet parsed
+	REBCNT count;		// gzip header, field or trailer byte count
+	REBYTE tail[8];		// gzip trailer as read
+} REBZST;
+
+
+/***********************************************************************
+**
+*/	static void Trap_Zlib(REBINT err)
+/*
+***********************************************************************/
+{
+	if (err == Z_MEM_ERROR) Trap0(RE_NO_MEMORY);
+	SET_INTEGER(DS_RETURN, err);
+	Trap1(RE_BAD_PRESS, DS_RETURN);
+}
+
+
+/***********************************************************************
+**
+*/	static void Reset_Stream(REBZST *zs)
+/*
+**		Prepare for a new stream (after OPEN or at end of stream).
+**
+***********************************************************************/
+{
+	zs->mode = (zs->format == SYM_GZIP) ? ZS_HEAD : ZS_BODY;
+	zs->crc = 0;
+	zs->size = 0;
+	zs->count = 0;
+}
+
+
+/***********************************************************************
+**
+*/	static REBZST *Open_Stream(REBSER *port, REBFLG deflate)
+/*
+**		Create the port state for the format and level of the spec.
+**
+***********************************************************************/
+{
+	REBVAL *spec = BLK_SKIP(port, STD_PORT_SPEC);
+	REBVAL *format = Obj_Value(spec, STD_PORT_SPEC_ZLIB_FORMAT);
+	REBVAL *level = Obj_Value(spec, STD_PORT_SPEC_ZLIB_LEVEL);
+	REBINT sym = SYM_ZLIB;
+	REBINT lev = Z_DEFAULT_COMPRESSION;
+	REBSER *ser;
+	REBZST *zs;
+	REBINT err;
+
+	if (format && !IS_NONE(format)) {
+		if (IS_WORD(format)) sym = VAL_WORD_CANON(format);
+		if (!IS_WORD(format) || (sym != SYM_ZLIB && sym != SYM_GZIP && sym != SYM_RAW))
+			Trap1(RE_INVALID_SPEC, format);
+	}
+
+	if (level && !IS_NONE(level)) {
+		if (!IS_INTEGER(level) || VAL_INT64(level) < 0 || VAL_INT64(level) > 9)
+			Trap1(RE_INVALID_SPEC, level);
+		lev = VAL_INT32(level);
+	}
+
+	ser = Make_Binary(sizeof(REBZST));
+	CLEAR(BIN_HEAD(ser), sizeof(REBZST));
+	SERIES_TAIL(ser) = sizeof(REBZST);
+	Set_Binary(BLK_SKIP(port, STD_PORT_STATE), ser);
+
+	zs = (REBZST *)BIN_HEAD(ser);
+	zs->deflate = deflate;
+	zs->format = sym;
+	Reset_Stream(zs);
+
+	// Zlib framing, or none (negative window bits) for raw and gzip:
+	zs->strm.checksum = adler32;
+	if (deflate)
+		err = deflateInit2(&zs->strm, lev, Z_DEFLATED, sym == SYM_ZLIB ? MAX_WBITS : -MAX_WBITS, 8, Z_DEFAULT_STRATEGY);
+	else
+		err = inflateInit2(&zs->strm, sym == SYM_ZLIB ? MAX_WBITS : -MAX_WBITS);
+
+	if (err != Z_OK) {
+		SET_NONE(BLK_SKIP(port, STD_PORT_STATE));
+		Trap_Zlib(err);
+	}
+
+	return zs;
+}
+
+
+/***********************************************************************
+**
+*/	static void Close_Stream(REBSER *port, REBZST *zs)
+/*
+***********************************************************************/
+{
+	if (zs->deflate) deflateEnd(&zs->strm);
+	else inflateEnd(&zs->strm);
+	Free_Port_State(port);
+}
+
+
+/***********************************************************************
+**
+*/	static REBSER *Output_Buffer(REBSER *port)
+/*
+**		Return the binary (port/data) that output is appended to.
+**
+***********************************************************************/
+{
+	REBVAL *data = BLK_SKIP(port, STD_PORT_DATA);
+
+	if (!IS_BINARY(data)) Set_Binary(data, Make_Binary(ZCHUNK));
+	return VAL_SERIES(data);
+}
+
+
+/***********************************************************************
+**
+*/	static void Set_Output(REBZST *zs, REBSER *out)
+/*
+**		Point zlib at the free space of the output binary,
+**		making room if needed.
+**
+***********************************************************************/
+{
+	if (SERIES_AVAIL(out) < ZCHUNK / 4) Extend_Series(out, ZCHUNK);
+	zs->strm.next_out = BIN_TAIL(out);
+	zs->strm.avail_out = SERIES_AVAIL(out) - 1; // keep terminator
+}
+
+
+/***********************************************************************
+**
+*/	static void Append_Long_LE(REBSER *out, REBCNT n)
+/*
+***********************************************************************/
+{
+	REBYTE b[4];
+
+	b[0] = (REBYTE)n;
+	b[1] = (REBYTE)(n >> 8);
+	b[2] = (REBYTE)(n >> 16);
+	b[3] = (REBYTE)(n >> 24);
+	Append_Series(out, b, 4);
+}
+
+
+/***********************************************************************
+**
+*/	static REBCNT Long_LE(REBYTE *bp)
+/*
+***********************************************************************/
+{
+	return bp[0] | (bp[1] << 8) | (bp[2] << 16) | ((REBCNT)bp[3] << 24);
+}
+
+
+/***********************************************************************
+**
+*/	static void Deflate_Stream(REBZST *zs, REBYTE *data, REBCNT len, REBINT flush, REBSER *out)
+/*
+**		Compress len bytes, appending output to the out binary.
+**		Z_FINISH ends the stream (and writes the gzip trailer).
+**
+***********************************************************************/
+{
+	static const REBYTE gz_head[10] = {0x1f, 0x8b, Z_DEFLATED, 0, 0, 0, 0, 0, 0, 255};
+	REBYTE *bp;
+	REBINT err;
+
+	if (zs->mode == ZS_DONE) {
+		deflateReset(&zs->strm);
+		Reset_Stream(zs);
+	}
+
+	if (zs->mode == ZS_HEAD) {
+		Append_Series(out, (REBYTE*)gz_head, sizeof(gz_head));
+		zs->mode = ZS_BODY;
+	}
+
+	if (zs->format == SYM_GZIP) {
+		zs->crc = Update_CRC32(zs->crc, data, len);
+		zs->size += len;
+	}
+
+	zs->strm.next_in = data;
+	zs->strm.avail_in = len;
+
+	do {
+		Set_Output(zs, out);
+		bp = zs->strm.next_out;
+		err = deflate(&zs->strm, flush);
+		SERIES_TAIL(out) += zs->strm.next_out - bp;
+		if (err != Z_OK && err != Z_STREAM_END && err != Z_BUF_ERROR) Trap_Zlib(err);
+	} while (flush == Z_FINISH ? err != Z_STREAM_END : zs->strm.avail_out == 0);
+
+	if (flush == Z_FINISH) {
+		if (zs->format == SYM_GZIP) {
+			Append_Long_LE(out, zs->crc);
+			Append_Long_LE(out, zs->size);
+		}
+		zs->mode = ZS_DONE;
+	}
+
+	SET_STR_END(out, SERIES_TAIL(out));
+}
+
+
+/***********************************************************************
+**
+*/	static void Next_Gzip_Field(REBZST *zs)
+/*
+**		Advance to the next optional field of the gzip header.
+**
+***********************************************************************/
+{
+	zs->count = 0;
+	if (zs->flags & GZ_FEXTRA) {
+		zs->flags &= ~GZ_FEXTRA;
+		zs->mode = ZS_EXTRA_LEN;
+	}
+	else if (zs->flags & GZ_FNAME) {
+		zs->flags &= ~GZ_FNAME;
+		zs->mode = ZS_NAME;
+	}
+	else if (zs->flags & GZ_FCOMMENT) {
+		zs->flags &= ~GZ_FCOMMENT;
+		zs->mode = ZS_COMMENT;
+	}
+	else if (zs->flags & GZ_FHCRC) {
+		zs->flags &= ~GZ_FHCRC;
+		zs->count = 2;
+		zs->mode = ZS_SKIP;
+	}
+	else zs->mode = ZS_BODY;
+}
+
+
+/***********************************************************************
+**
+*/	static void Inflate_Stream(REBZST *zs, REBYTE *data, REBCNT len, REBSER *out)
+/*
+**		Decompress len bytes, appending output to the out binary.
+**		The gzip header and trailer may be split over any number
+**		of writes. Data past the end of a zlib or raw stream is
+**		ignored.
+**
+***********************************************************************/
+{
+	REBYTE *bp;
+	REBINT err;
+	REBCNT n;
+
+	while (len > 0) {
+		switch (zs->mode) {
+
+		case ZS_HEAD:
+			n = *data++, len--;
+			if (
+				(zs->count == 0 && n != 0x1f) ||
+				(zs->count == 1 && n != 0x8b) ||
+				(zs->count == 2 && n != Z_DEFLATED)
+			) Trap_Zlib(Z_DATA_ERROR);
+			if (zs->count == 3) zs->flags = n;
+			if (++zs->count == 10) Next_Gzip_Field(zs);
+			break;
+
+		case ZS_EXTRA_LEN:
+			n = *data++, len--;
+			if (zs->count++ == 0) zs->size = n;
+			else {
+				zs->count = zs->size | (n << 8);
+				zs->size = 0;
+				zs->mode = ZS_SKIP;
+			}
+			break;
+
+		case ZS_SKIP:
+			n = MIN(len, zs->count);
+			data += n, len -= n;
+			zs->count -= n;
+			if (zs->count == 0) Next_Gzip_Field(zs);
+			break;
+
+		case ZS_NAME:
+		case ZS_COMMENT:
+			bp = memchr(data, 0, len);
+			n = bp ? (bp - data) + 1 : len;
+			data += n, len -= n;
+			if (bp) Next_Gzip_Field(zs);
+			break;
+
+		case ZS_BODY:
+			zs->strm.next_in = data;
+			zs->strm.avail_in = len;
+			do {
+				Set_Output(zs, out);
+				bp = zs->strm.next_out;
+				err = inflate(&zs->strm, Z_SYNC_FLUSH);
+				n = zs->strm.next_out - bp;
+				if (zs->format == SYM_GZIP) {
+					zs->crc = Update_CRC32(zs->crc, bp, n);
+					zs->size += n;
+				}
+				SERIES_TAIL(out) += n;
+				if (err == Z_BUF_ERROR) break;	// needs more input
+				if (err != Z_OK && err != Z_STREAM_END) Trap_Zlib(err);
+			} while (err != Z_STREAM_END && (zs->strm.avail_in > 0 || zs->strm.avail_out == 0));
+			data = zs->strm.next_in;
+			len = zs->strm.avail_in;
+			if (err == Z_STREAM_END) {
+				zs->count = 0;
+				zs->mode = (zs->format == SYM_GZIP) ? ZS_TAIL : ZS_DONE;
+			}
+			break;
+
+		case ZS_TAIL:
+			zs->tail[zs->count++] = *data++, len--;
+			if (zs->count == 8) {
+				if (
+					zs->crc != Long_LE(zs->tail) ||
+					zs->size != Long_LE(zs->tail + 4)
+				) Trap_Zlib(Z_DATA_ERROR);
+				zs->mode = ZS_DONE;
+			}
+			break;
+
+		case ZS_DONE:
+			if (zs->format == SYM_GZIP) {
+				// Another gzip member follows:
+				inflateReset(&zs->strm);
+				Reset_Stream(zs);
+			}
+			else len = 0;
+			break;
+		}
+	}
+
+	SET_STR_END(out, SERIES_TAIL(out));
+}
+
+
+/***********************************************************************
+**
+*/	static void Write_Target(REBSER *port)
+/*
+**		Write pending output to the target port (if there is one).
+**		The target gets the output binary itself; a new one is made
+**		for further output.
+**
+***********************************************************************/
+{
+	REBVAL *target = Obj_Value(BLK_SKIP(port, STD_PORT_SPEC), STD_PORT_SPEC_ZLIB_TARGET);
+	REBVAL *data = BLK_SKIP(port, STD_PORT_DATA);
+	REBVAL *write = Get_Action_Value(A_WRITE);
+	REBVAL out;
+
+	if (!target || !IS_PORT(target) || !IS_BINARY(data) || VAL_LEN(data) == 0) return;
+
+	out = *data;
+	SET_NONE(data);
+	Apply_Func(VAL_FUNC_SPEC(write), write, target, &out, 0);
+}
+
+
+/***********************************************************************
+**
+*/	static int Compress_Actor(REBVAL *ds, REBSER *port, REBCNT action, REBFLG deflate)
+/*
+***********************************************************************/
+{
+	REBVAL *state;
+	REBVAL *arg;
+	REBZST *zs = 0;
+	REBSER *ser;
+	REBVAL *data;
+	REBYTE *bp;
+	REBCNT refs;
+	REBCNT len;
+
+	Validate_Port(port, action);
+
+	arg = D_ARG(2);
+	state = BLK_SKIP(port, STD_PORT_STATE);
+	if (IS_BINARY(state)) zs = (REBZST *)VAL_BIN(state);
+
+	switch (action) {
+
+	case A_WRITE:
+		if (!IS_STRING(arg) && !IS_BINARY(arg)) Trap1(RE_INVALID_PORT_ARG, arg);
+		if (!zs) zs = Open_Stream(port, deflate);
+
+		refs = Find_Refines(ds, ALL_WRITE_REFS);
+		len = VAL_LEN(arg);
+		if (refs & AM_WRITE_PART) {
+			REBCNT n = Int32s(D_ARG(ARG_WRITE_LENGTH), 0);
+			if (n <= len) len = n;
+		}
+
+		// Strings are compressed as UTF-8:
+		bp = VAL_BIN_DATA(arg);
+		if (IS_STRING(arg) && (ser = Encode_UTF8_Value(arg, len, ENCF_NO_COPY))) {
+			bp = BIN_HEAD(ser);
+			len = SERIES_TAIL(ser);
+		}
+
+		if (deflate) Deflate_Stream(zs, bp, len, Z_NO_FLUSH, Output_Buffer(port));
+		else Inflate_Stream(zs, bp, len, Output_Buffer(port));
+		Write_Target(port);
+		break;
+
+	case A_UPDATE:
+		// End of input:
+		if (!zs) Trap_Port(RE_NOT_OPEN, port, 0);
+		if (deflate) {
+			if (zs->mode != ZS_DONE) Deflate_Stream(zs, 0, 0, Z_FINISH, Output_Buffer(port));
+		}
+		else {
+			// Raw inflate needs a byte past the end to see it:
+			if (zs->format == SYM_RAW && zs->mode == ZS_BODY) Inflate_Stream(zs, (REBYTE*)"", 1, Output_Buffer(port));
+			if (zs->mode != ZS_DONE) Trap_Zlib(Z_BUF_ERROR);
+		}
+		Write_Target(port);
+		break;
+
+	case A_READ:
+		// Take the output so far:
+		if (!zs) Trap_Port(RE_NOT_OPEN, port, 0);
+		data = BLK_SKIP(port, STD_PORT_DATA);
+		if (IS_BINARY(data)) *D_RET = *data;
+		else Set_Binary(D_RET, Make_Binary(0));
+		SET_NONE(data);
+		return R_RET;
+
+	case A_LENGTHQ:
+		if (!zs) Trap_Port(RE_NOT_OPEN, port, 0);
+		data = BLK_SKIP(port, STD_PORT_DATA);
+		SET_INTEGER(D_RET, IS_BINARY(data) ? VAL_LEN(data) : 0);
+		return R_RET;
+
+	case A_TAILQ:
+		if (zs && zs->mode == ZS_DONE) return R_TRUE;
+		return R_FALSE;
+
+	case A_OPEN:
+		if (zs) Trap_Port(RE_ALREADY_OPEN, port, 0);
+		Open_Stream(port, deflate);
+		break;
+
+	case A_CLOSE:
+		if (!zs) break;
+		if (deflate && zs->mode != ZS_DONE) {
+			Deflate_Stream(zs, 0, 0, Z_FINISH, Output_Buffer(port));
+			Write_Target(port);
+		}
+		Close_Stream(port, zs);
+		SET_NONE(BLK_SKIP(port, STD_PORT_DATA));
+		break;
+
+	case A_OPENQ:
+		if (zs) return R_TRUE;
+		return R_FALSE;
+
+	default:
+		Trap_Action(REB_PORT, action);
+	}
+
+	return R_ARG1; // port
+}
+
+
+/***********************************************************************
+**
+*/	static int Deflate_Actor(REBVAL *ds, REBSER *port, REBCNT action)
+/*
+***********************************************************************/
+{
+	return Compress_Actor(ds, port, action, TRUE);
+}
+
+
+/***********************************************************************
+**
+*/	static int Inflate_Actor(REBVAL *ds, REBSER *port, REBCNT action)
+/*
+***********************************************************************/
+{
+	return Compress_Actor(ds, port, action, FALSE);
+}
+
+
+/***********************************************************************
+**
+*/	void Init_Compress_Scheme(void)
+/*
+***********************************************************************/
+{
+	Register_Scheme(SYM_DEFLATE, 0, Deflate_Actor);
+	Register_Scheme(SYM_INFLATE, 0, Inflate_Actor);
+}
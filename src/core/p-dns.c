@@ -104,6 +104,8 @@ pick:
 			}
 			if (GET_FLAG(sock->modes, RST_REVERSE)) {
 				Set_String(D_RET, Copy_Bytes(sock->data, LEN_BYTES(sock->data)));
+			} else if (GET_FLAG(sock->modes, RST_IPV6) && !sock->net.remote_ip) {
+				Set_String(D_RET, Form_IPv6(sock->net.remote_ip6)); // IPv6 only host
 			} else {
 				Set_Tuple(D_RET, (REBYTE*)&sock->net.remote_ip, 4);
 			}
@@ -34,6 +34,9 @@
 #define READ_MAX ((REBCNT)(-1))
 #define HL64(v) (v##l + (v##h << 32))
 #define MAX_READ_MASK 0x7FFFFFFF // max size per chunk
+#define LINE_CHUNK 65536 // bytes read at a time for READ/LINES of an open port
+#define LINE_LIMIT (16 * LINE_CHUNK) // longer lines are returned in pieces
+#define WRITE_CHUNK 32768 // chars of a string encoded at a time for WRITE
 
 
 /***********************************************************************
@@ -49,6 +52,7 @@
 	if (args & AM_OPEN_WRITE) SET_FLAG(file->modes, RFM_WRITE);
 	if (args & AM_OPEN_READ) SET_FLAG(file->modes, RFM_READ);
 	if (args & AM_OPEN_SEEK) SET_FLAG(file->modes, RFM_SEEK);
+	if (args & AM_OPEN_ASYNC) SET_FLAG(file->modes, RFM_ASYNC);
 
 	if (args & AM_OPEN_NEW) {
 		SET_FLAG(file->modes, RFM_NEW);
@@ -124,6 +128,23 @@
 }
 
 
+/***********************************************************************
+**
+*/	static REBCNT Buffer_Size(REBVAL *spec)
+/*
+**		Get the write buffer size of a port from its spec: bytes,
+**		or zero (or NONE, the default) to write through.
+**
+***********************************************************************/
+{
+	REBVAL *val = Obj_Value(spec, STD_PORT_SPEC_FILE_BUFFER);
+
+	if (!val || IS_NONE(val)) return 0;
+	if (!IS_INTEGER(val)) Trap1(RE_INVALID_SPEC, val);
+	return Int32s(val, 0);
+}
+
+
 /***********************************************************************
 **
 */	static void Open_File_Port(REBSER *port, REBREQ *file, REBVAL *path)
@@ -183,23 +204,45 @@ REBINT Mode_Syms[] = {
 **
 */	static void Read_File_Port(REBSER *port, REBREQ *file, REBVAL *path, REBCNT args, REBCNT len)
 /*
-**		Read from a file port.
+**		Read from a file port. With /mmap the result is the
+**		file mapped into memory: a fixed length binary that is
+**		not copied, and is unmapped when it is collected.
 **
 ***********************************************************************/
 {
 	REBSER *ser;
 	REBVAL *ds = DS_RETURN;
+	REBYTE *map;
 
-	// Allocate read result buffer:
-	ser = Make_Binary(len);
-	Set_Series(REB_BINARY, ds, ser); //??? what if already set?
+	// Held writes must be in the file before it is mapped:
+	if ((args & AM_READ_MMAP) && file->file.buffer_size) {
+		file->length = 0;
+		OS_DO_DEVICE(file, RDC_WRITE);
+	}
 
-	// Do the read, check for errors:
-	file->data = BIN_HEAD(ser);
-	file->length = len;
-	if (OS_DO_DEVICE(file, RDC_READ) < 0) Trap_Port(RE_READ_ERROR, port, file->error);
-	SERIES_TAIL(ser) = file->actual;
-	STR_TERM(ser);
+	// Map the file rather than read it, if possible (copy-on-write):
+	if (
+		(args & AM_READ_MMAP) && len > 0 && file->file.index >= 0
+		&& NZ(map = OS_MAP_FILE(file, file->file.index, len))
+	) {
+		ser = Make_Map_Series(map, len);
+		Set_Series(REB_BINARY, ds, ser);
+		file->actual = len;
+		file->file.index += len;
+		SET_FLAG(file->modes, RFM_RESEEK); // (the handle was not moved)
+	}
+	else {
+		// Allocate read result buffer:
+		ser = Make_Binary(len);
+		Set_Series(REB_BINARY, ds, ser); //??? what if already set?
+
+		// Do the read, check for errors:
+		file->data = BIN_HEAD(ser);
+		file->length = len;
+		if (OS_DO_DEVICE(file, RDC_READ) < 0) Trap_Port(RE_READ_ERROR, port, file->error);
+		SERIES_TAIL(ser) = file->actual;
+		STR_TERM(ser);
+	}
 
 	// Convert to string or block of strings.
 	// NOTE: This code is incorrect for files read in chunks!!!
@@ -211,6 +254,140 @@ REBINT Mode_Syms[] = {
 }
 
 
+/***********************************************************************
+**
+*/	static void Read_File_Lines(REBSER *port, REBREQ *file, REBCNT count)
+/*
+**		Read the next count lines of an open file port (or all
+**		the rest for READ_MAX). The file is read in fixed size
+**		chunks and the bytes after the last line returned are
+**		held in port/data for the next read, so a file of any
+**		size can be read line by line in constant memory.
+**
+**		Lines end with LF, CR or CRLF and are decoded as UTF-8.
+**		A line longer than LINE_LIMIT bytes is returned in pieces
+**		(split between characters), so the buffer stays bounded.
+**		At the end of the file NONE is returned.
+**
+***********************************************************************/
+{
+	REBVAL *ds = DS_RETURN;
+	REBVAL *data = OFV(port, STD_PORT_DATA);
+	REBSER *buf;
+	REBSER *blk;
+	REBVAL *val;
+	REBYTE *bp;
+	REBCNT start = 0;	// start of the current line
+	REBCNT n = 0;		// scan position
+	REBCNT tail;
+	REBCNT cut;
+	REBOOL eof = FALSE;
+
+	if (!IS_BINARY(data)) {
+		Set_Binary(data, Make_Binary(LINE_CHUNK));
+		// Skip a UTF-8 BOM at the start of the file:
+		if (file->file.index == 0) {
+			file->data = BIN_HEAD(VAL_SERIES(data));
+			file->length = 3;
+			if (OS_DO_DEVICE(file, RDC_READ) < 0) Trap_Port(RE_READ_ERROR, port, file->error);
+			if (file->actual == 3 && What_UTF(file->data, 3) == 8) file->actual = 0;
+			SERIES_TAIL(VAL_SERIES(data)) = file->actual;
+		}
+	}
+	buf = VAL_SERIES(data);
+
+	blk = Make_Block(count < 256 ? count : 256);
+	Set_Block(ds, blk);
+
+	while (count > 0) {
+		bp = BIN_HEAD(buf);
+		tail = SERIES_TAIL(buf);
+		while (n < tail && bp[n] != LF && bp[n] != CR) n++;
+
+		// A CR at the end of the buffer may be followed by an LF:
+		if ((n < tail && (bp[n] == LF || n + 1 < tail || eof)) || (eof && n > start)) {
+			val = Append_Value(blk);
+			Set_String(val, Decode_UTF_String(bp + start, n - start, 8));
+			VAL_SET_LINE(val);
+			if (n < tail && bp[n++] == CR && n < tail && bp[n] == LF) n++;
+			start = n;
+			count--;
+			continue;
+		}
+		if (eof) break;
+
+		// Return a piece of a very long line, ending before its last char:
+		if (n - start >= LINE_LIMIT) {
+			for (cut = n - 1; cut > start && (bp[cut] & 0xC0) == 0x80; cut--);
+			if (cut == start) cut = n; // (not UTF-8)
+			val = Append_Value(blk);
+			Set_String(val, Decode_UTF_String(bp + start, cut - start, 8));
+			VAL_SET_LINE(val);
+			start = cut;
+			count--;
+			continue;
+		}
+
+		// Drop the lines done, then read the next chunk after the rest:
+		Remove_Series(buf, 0, start);
+		n -= start;
+		start = 0;
+		Extend_Series(buf, LINE_CHUNK);
+		file->data = BIN_TAIL(buf);
+		file->length = LINE_CHUNK;
+		if (OS_DO_DEVICE(file, RDC_READ) < 0) Trap_Port(RE_READ_ERROR, port, file->error);
+		SERIES_TAIL(buf) += file->actual;
+		if (file->actual == 0) eof = TRUE;
+	}
+
+	Remove_Series(buf, 0, start);
+	if (eof && SERIES_TAIL(blk) == 0) SET_NONE(ds);
+}
+
+
+/***********************************************************************
+**
+*/	static void Drop_File_Lines(REBSER *port, REBREQ *file)
+/*
+**		Forget the bytes held by READ/LINES, moving the file
+**		position back to the first of them.
+**
+***********************************************************************/
+{
+	REBVAL *data = OFV(port, STD_PORT_DATA);
+
+	if (!IS_BINARY(data)) return;
+
+	if (SERIES_TAIL(VAL_SERIES(data))) {
+		file->file.index -= SERIES_TAIL(VAL_SERIES(data));
+		SET_FLAG(file->modes, RFM_RESEEK);
+	}
+	SET_NONE(data);
+}
+
+
+/***********************************************************************
+**
+*/	static void Write_File_Chunk(void *req, REBYTE *data, REBCNT len)
+/*
+**		Output function for streaming mold (see Write_File_Port).
+**
+***********************************************************************/
+{
+	REBREQ *file = (REBREQ*)req;
+
+	if (file->error) return; // (reported by caller)
+
+	file->data = data;
+	file->length = len;
+	OS_DO_DEVICE(file, RDC_WRITE);
+
+	// Next chunk goes after this one if the write seeks:
+	if (file->modes & ((1 << RFM_SEEK) | (1 << RFM_TRUNCATE)))
+		file->file.index += file->actual;
+}
+
+
 /***********************************************************************
 **
 */	static void Write_File_Port(REBREQ *file, REBVAL *data, REBCNT len, REBCNT args)
@@ -220,26 +397,64 @@ REBINT Mode_Syms[] = {
 	REBSER *ser;
 
 	if (IS_BLOCK(data)) {
-		// Form the values of the block
-		// !! Could be made more efficient if we broke the FORM
-		// into 32K chunks for writing.
+		// Form the values of the block, writing it in chunks:
 		REB_MOLD mo = {0};
-		Reset_Mold(&mo);
+		mo.opts = 1 << MOPT_BYTES;
 		if (args & AM_WRITE_LINES) {
-			mo.opts = 1 << MOPT_LINES;
+			SET_FLAG(mo.opts, MOPT_LINES);
 		}
+		mo.flush = Write_File_Chunk;
+		mo.out = file;
+		Reset_Mold(&mo);
 		Mold_Value(&mo, data, 0);
-		Set_String(data, mo.series); // fall into next section
-		len = SERIES_TAIL(mo.series);
+		Flush_Mold(&mo, TRUE);
+		return;
 	}
 
-	// Auto convert string to UTF-8
+	// Auto convert string to UTF-8, a chunk at a time:
+	if (IS_STRING(data)) {
+		REBVAL val = *data;
+		REBCNT n;
+		for (; len > 0 && !file->error; len -= n, VAL_INDEX(&val) += n) {
+			n = MIN(len, WRITE_CHUNK);
+			ser = Encode_UTF8_Value(&val, n, ENCF_OS_CRLF | ENCF_NO_COPY);
+			if (ser) Write_File_Chunk(file, BIN_HEAD(ser), SERIES_TAIL(ser));
+			else Write_File_Chunk(file, VAL_BIN_DATA(&val), n); // No encoding was needed
+		}
+		return;
+	}
+
+	file->data = VAL_BIN_DATA(data);
+	file->length = len;
+	OS_DO_DEVICE(file, RDC_WRITE);
+}
+
+
+/***********************************************************************
+**
+*/	static void Write_File_Async(REBSER *port, REBREQ *file, REBVAL *data, REBCNT len)
+/*
+**		Start the write of an async file port. The data is held
+**		in port/data (GC safe) until the wrote event. Blocks are
+**		not formed for async writes.
+**
+***********************************************************************/
+{
+	REBVAL *hold = OFV(port, STD_PORT_DATA);
+	REBSER *ser;
+
+	if (IS_BLOCK(data)) Trap1(RE_INVALID_PORT_ARG, data);
+	if (len == 0) return; // (nothing to write, so no event)
+
 	if (IS_STRING(data)) {
 		ser = Encode_UTF8_Value(data, len, ENCF_OS_CRLF);
-		file->data = ser? BIN_HEAD(ser) : VAL_BIN_DATA(data); // No encoding may be needed
+		if (ser == BUF_FORM) ser = Copy_Bytes(BIN_HEAD(ser), SERIES_TAIL(ser)); // (shared)
+		Set_Binary(hold, ser);
+		file->data = BIN_HEAD(ser);
 		len = SERIES_TAIL(ser);
 	}
 	else {
+		*hold = *data;
 		file->data = VAL_BIN_DATA(data);
 	}
 	file->length = len;
@@ -312,6 +527,7 @@ REBINT Mode_Syms[] = {
 	REBREQ *file = 0;
 	REBCNT args = 0;
 	REBCNT len;
+	REBCNT held;
 	REBOOL opened = FALSE;	// had to be opened (shortcut case)
 
 	//Print("FILE ACTION: %r", Get_Action_Word(action));
@@ -332,6 +548,30 @@ REBINT Mode_Syms[] = {
 	// Get or setup internal state data:
 	file = (REBREQ*)Use_Port_State(port, RDI_FILE, sizeof(*file));
 
+	// Bytes read ahead by READ/LINES are not at the file position yet:
+	held = IS_BINARY(OFV(port, STD_PORT_DATA)) ? SERIES_TAIL(VAL_SERIES(OFV(port, STD_PORT_DATA))) : 0;
+	if (GET_FLAG(file->modes, RFM_ASYNC)) held = 0; // (port/data is the async buffer)
+
+	switch (action) {
+	case A_OPENQ:
+	case A_QUERY:
+	case A_INDEXQ:
+	case A_LENGTHQ:
+	case A_HEADQ:
+	case A_TAILQ:
+	case A_PASTQ:
+	case A_UPDATE:
+		break;
+	default:
+		// An async read or write must be done (its event) first:
+		if (GET_FLAG(file->flags, RRF_PENDING) && action != A_CLOSE)
+			Trap_Port(action == A_READ ? RE_READ_ERROR : RE_WRITE_ERROR, port, -RFE_BUSY);
+		if (action != A_READ && !GET_FLAG(file->modes, RFM_ASYNC)) {
+			Drop_File_Lines(port, file);
+			held = 0;
+		}
+	}
+
 	switch (action) {
 
 	case A_READ:
@@ -346,6 +586,31 @@ REBINT Mode_Syms[] = {
 			opened = TRUE;
 		}
 
+		// An async read is into port/data, done as a read event:
+		if (GET_FLAG(file->modes, RFM_ASYNC)) {
+			REBSER *ser;
+			if (args & AM_READ_SEEK) Set_Seek(file, D_ARG(ARG_READ_INDEX));
+			len = Set_Length(ds, file, ARG_READ_PART);
+			ser = Make_Binary(len);
+			Set_Binary(OFV(port, STD_PORT_DATA), ser);
+			file->data = BIN_HEAD(ser);
+			file->length = len;
+			if (OS_DO_DEVICE(file, RDC_READ) < 0) Trap_Port(RE_READ_ERROR, port, file->error);
+			break;
+		}
+
+		// Read the next lines of an open file (/part is the line count):
+		if ((args & AM_READ_LINES) && !opened) {
+			if (args & AM_READ_SEEK) {
+				Drop_File_Lines(port, file);
+				Set_Seek(file, D_ARG(ARG_READ_INDEX));
+			}
+			Read_File_Lines(port, file, (args & AM_READ_PART)
+				? Int32s(D_ARG(ARG_READ_LENGTH), 0) : READ_MAX);
+			break;
+		}
+
+		Drop_File_Lines(port, file);
 		if (args & AM_READ_SEEK) Set_Seek(file, D_ARG(ARG_READ_INDEX));
 		len = Set_Length(ds, file, ARG_READ_PART);
 		Read_File_Port(port, file, path, args, len);
@@ -360,12 +625,13 @@ REBINT Mode_Syms[] = {
 		break;
 
 	case A_APPEND:
-		file->file.index = file->file.size;
+		file->file.index = -1; // append (size is not updated by writes)
 		SET_FLAG(file->modes, RFM_RESEEK);
 
 	case A_WRITE:
 		args = Find_Refines(ds, ALL_WRITE_REFS);
 		spec = D_ARG(2); // data (binary, string, or block)
+		if (IS_PORT(spec)) Trap1(RE_INVALID_PORT_ARG, spec);
 
 		// Handle the READ %file shortcut case:
 		if (!IS_OPEN(file)) {
@@ -394,7 +660,8 @@ REBINT Mode_Syms[] = {
 			if (n <= len) len = n;
 		}
 
-		Write_File_Port(file, spec, len, args);
+		if (GET_FLAG(file->modes, RFM_ASYNC)) Write_File_Async(port, file, spec, len);
+		else Write_File_Port(file, spec, len, args);
 
 		if (opened) {
 			OS_DO_DEVICE(file, RDC_CLOSE);
@@ -410,11 +677,32 @@ REBINT Mode_Syms[] = {
 		// Default file modes if not specified:
 		if (!(args & (AM_OPEN_READ | AM_OPEN_WRITE))) args |= (AM_OPEN_READ | AM_OPEN_WRITE);
 		Setup_File(file, args, path);
+		if ((args & AM_OPEN_WRITE) && !(args & AM_OPEN_ASYNC))
+			file->file.buffer_size = Buffer_Size(spec);
 		Open_File_Port(port, file, path); // !!! needs to change file modes to R/O if necessary
 		break;
 
+	case A_FLUSH:
+		// Write out bytes held by the write buffer:
+		if (!IS_OPEN(file)) Trap1(RE_NOT_OPEN, path);
+		file->length = 0;
+		if (OS_DO_DEVICE(file, RDC_WRITE) < 0) Trap_Port(RE_WRITE_ERROR, port, file->error);
+		break;
+
+	case A_UPDATE:
+		// Update the port object after an async READ or WRITE.
+		// This is normally called by the WAKE-UP function.
+		spec = OFV(port, STD_PORT_DATA);
+		if (file->command == RDC_READ && IS_BINARY(spec)) {
+			SERIES_TAIL(VAL_SERIES(spec)) = file->actual;
+			STR_TERM(VAL_SERIES(spec));
+		}
+		else if (file->command == RDC_WRITE) SET_NONE(spec);
+		return R_NONE;
+
 	case A_COPY:
 		if (!IS_OPEN(file)) Trap1(RE_NOT_OPEN, path); //!!!! wrong msg
+		if (GET_FLAG(file->modes, RFM_ASYNC)) Trap_Action(REB_PORT, action); // (use READ)
 		len = Set_Length(ds, file, 2);
 		Read_File_Port(port, file, path, args, len);
 		break;
@@ -425,9 +713,12 @@ REBINT Mode_Syms[] = {
 
 	case A_CLOSE:
 		if (IS_OPEN(file)) {
-			OS_DO_DEVICE(file, RDC_CLOSE);
+			// Held writes are written by the close:
+			REBINT result = OS_DO_DEVICE(file, RDC_CLOSE);
+			REBINT error = file->error;
 			Cleanup_File(file);
 			Free_Port_State(port);
+			if (result < 0) Trap_Port(RE_WRITE_ERROR, port, error);
 		}
 		break;
 
@@ -468,6 +759,10 @@ REBINT Mode_Syms[] = {
 			Setup_File(file, 0, path);
 			if (OS_DO_DEVICE(file, RDC_QUERY) < 0) return R_NONE;
 		}
+		else if (!GET_FLAG(file->flags, RRF_PENDING)) {
+			// Write out held bytes and get the current size:
+			if (OS_DO_DEVICE(file, RDC_QUERY) < 0) Trap_Port(RE_WRITE_ERROR, port, file->error);
+		}
 		Ret_Query_File(port, file, D_RET);
 		// !!! free file path?
 		break;
@@ -482,11 +777,11 @@ REBINT Mode_Syms[] = {
 		break;
 
 	case A_INDEXQ:
-		SET_INTEGER(D_RET, file->file.index + 1);
+		SET_INTEGER(D_RET, file->file.index - held + 1);
 		break;
 
 	case A_LENGTHQ:
-		SET_INTEGER(D_RET, file->file.size - file->file.index); // !clip at zero
+		SET_INTEGER(D_RET, file->file.size - file->file.index + held); // !clip at zero
 		break;
 
 	case A_HEAD:
@@ -510,13 +805,13 @@ REBINT Mode_Syms[] = {
 		goto seeked;
 
     case A_HEADQ:
-		DECIDE(file->file.index == 0);
+		DECIDE(file->file.index - held == 0);
 
     case A_TAILQ:
-		DECIDE(file->file.index >= file->file.size);
+		DECIDE(file->file.index - held >= file->file.size);
 
     case A_PASTQ:
-		DECIDE(file->file.index > file->file.size);
+		DECIDE(file->file.index - held > file->file.size);
 
 	case A_CLEAR:
 		// !! check for write enabled?
@@ -539,7 +834,6 @@ REBINT Mode_Syms[] = {
 		A_CHANGE,				// 53
 		A_POKE,					// 54
 		A_QUERY,				// 64
-		A_FLUSH,				// 65
 	*/
 
 	default:
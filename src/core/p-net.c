@@ -33,6 +33,124 @@
 #include "reb-evtypes.h"
 
 #define NET_BUF_SIZE 32*1024
+#define NET_BUF_MAX (4*1024*1024)	// largest read buffer extension
+#define UDP_BATCH 64				// most datagrams taken per read
+#define UDP_BUF_SIZE 2048			// datagram buffer size (READ/PART sets it)
+#define UDP_BUF_MAX 65507			// largest UDP datagram
+
+/***********************************************************************
+**
+*/	REBSER *Form_IPv6(REBYTE *ip6)
+/*
+**		Form an IPv6 address as a string (RFC 5952: lowercase hex,
+**		the longest run of zero groups shortened to ::).
+**		Tuples hold at most 10 bytes, so IPv6 addresses are strings.
+**
+***********************************************************************/
+{
+	REBYTE buf[40];
+	REBYTE *bp = buf;
+	REBINT best = -1;
+	REBINT most = 1;
+	REBINT run;
+	REBINT n;
+	REBINT s;
+	REBCNT g;
+
+	// Find the longest run of zero groups (two or more):
+	for (n = 0; n < 8; n += run ? run : 1) {
+		for (run = 0; n + run < 8 && !ip6[2*(n+run)] && !ip6[2*(n+run)+1]; run++);
+		if (run > most) {most = run; best = n;}
+	}
+
+	for (n = 0; n < 8; n++) {
+		if (n == best) {
+			if (n == 0) *bp++ = ':';
+			*bp++ = ':';
+			n += most - 1;
+			continue;
+		}
+		g = (ip6[2*n] << 8) | ip6[2*n+1];
+		for (s = 12; s > 0 && !(g >> s); s -= 4);
+		for (; s >= 0; s -= 4) *bp++ = "0123456789abcdef"[(g >> s) & 0xf];
+		if (n < 7) *bp++ = ':';
+	}
+	*bp = 0;
+
+	return Copy_Bytes(buf, bp - buf);
+}
+
+
+/***********************************************************************
+**
+*/	REBOOL Scan_IPv6(REBYTE *cp, REBCNT len, REBYTE *ip6)
+/*
+**		Scan an IPv6 address: hex groups, with at most one ::
+**		for a run of zero groups. Returns FALSE if not valid.
+**
+***********************************************************************/
+{
+	REBYTE *ep = cp + len;
+	REBINT gap = -1;	// group where :: is
+	REBINT n = 0;		// groups scanned
+	REBINT d;
+	REBCNT g;
+	REBCNT c;
+
+	CLEAR(ip6, 16);
+	if (len >= 2 && cp[0] == ':' && cp[1] == ':') {
+		gap = 0;
+		cp += 2;
+	}
+
+	while (cp < ep) {
+		if (n == 8) return FALSE;
+		for (g = 0, d = 0; cp < ep && d < 5; cp++, d++) {
+			c = *cp;
+			if (c >= '0' && c <= '9') c -= '0';
+			else if (c >= 'a' && c <= 'f') c -= 'a' - 10;
+			else if (c >= 'A' && c <= 'F') c -= 'A' - 10;
+			else break;
+			g = (g << 4) | c;
+		}
+		if (d == 0 || d > 4) return FALSE;
+		ip6[2*n] = (REBYTE)(g >> 8);
+		ip6[2*n+1] = (REBYTE)g;
+		n++;
+		if (cp == ep) break;
+		if (*cp++ != ':' || cp == ep) return FALSE;
+		if (*cp == ':') {
+			if (gap >= 0) return FALSE;
+			gap = n;
+			cp++;
+		}
+	}
+
+	// Move the groups after :: to the end:
+	if (gap >= 0) {
+		if (n == 8) return FALSE;
+		memmove(ip6 + 16 - 2*(n-gap), ip6 + 2*gap, 2*(n-gap));
+		CLEAR(ip6 + 2*gap, 16 - 2*n);
+	}
+	else if (n != 8) return FALSE;
+
+	return TRUE;
+}
+
+
+/***********************************************************************
+**
+*/	static void Set_Net_IP(REBVAL *val, REBOOL ipv6, REBYTE *ip, REBYTE *ip6)
+/*
+**		Set a network address: a tuple, or for an IPv6 address,
+**		a string.
+**
+***********************************************************************/
+{
+	if (ipv6) Set_String(val, Form_IPv6(ip6));
+	else Set_Tuple(val, ip, 4);
+}
+
 
 /***********************************************************************
 **
@@ -48,8 +166,10 @@
 	obj = CLONE_OBJECT(VAL_OBJ_FRAME(info));
 
 	SET_OBJECT(ret, obj);
-	Set_Tuple(OFV(obj, STD_NET_INFO_LOCAL_IP), (REBYTE*)&sock->net.local_ip, 4);
-	Set_Tuple(OFV(obj, STD_NET_INFO_REMOTE_IP), (REBYTE*)&sock->net.remote_ip, 4);
+	Set_Net_IP(OFV(obj, STD_NET_INFO_LOCAL_IP), GET_FLAG(sock->modes, RST_LOCAL6),
+		(REBYTE*)&sock->net.local_ip, sock->net.local_ip6);
+	Set_Net_IP(OFV(obj, STD_NET_INFO_REMOTE_IP), GET_FLAG(sock->modes, RST_IPV6),
+		(REBYTE*)&sock->net.remote_ip, sock->net.remote_ip6);
 	SET_INTEGER(OFV(obj, STD_NET_INFO_LOCAL_PORT), sock->net.local_port);
 	SET_INTEGER(OFV(obj, STD_NET_INFO_REMOTE_PORT), sock->net.remote_port);
 }
@@ -89,8 +209,260 @@
 
 /***********************************************************************
 **
-*/	static int TCP_Actor(REBVAL *ds, REBSER *port, REBCNT action)
+*/	static REBCNT Write_Net_Vector(REBSER *port, REBREQ *sock, REBVAL *blk, REBCNT part)
+/*
+**		Setup a scatter/gather write of a block of binaries, so
+**		they are sent without first being joined. The block and
+**		the buffer array are held in the port data (GC safe)
+**		until the write is done. Returns the length to send.
+**
+***********************************************************************/
+{
+	REBVAL *val;
+	REBSER *vecs;
+	REBSER *hold;
+	REBIOV *vec;
+	REBCNT len = 0;
+
+	for (val = VAL_BLK_DATA(blk); NOT_END(val); val++)
+		if (!IS_BINARY(val)) Trap1(RE_INVALID_PORT_ARG, val);
+
+	vecs = Make_Binary(VAL_LEN(blk) * sizeof(REBIOV));
+	vec = (REBIOV*)BIN_HEAD(vecs);
+	for (val = VAL_BLK_DATA(blk); NOT_END(val) && len < part; val++, vec++) {
+		vec->data = VAL_BIN_DATA(val);
+		vec->len = MIN(VAL_LEN(val), part - len);
+		len += vec->len;
+	}
+
+	hold = Make_Block(2);
+	Append_Val(hold, blk);
+	Set_Binary(Append_Value(hold), vecs);
+	Set_Block(OFV(port, STD_PORT_DATA), hold);
+
+	SET_FLAG(sock->state, RSM_VECTOR);
+	sock->data = BIN_HEAD(vecs);
+	return len;
+}
+
+
+/***********************************************************************
+**
+*/	static REBCNT Write_Net_File(REBSER *port, REBREQ *sock, REBVAL *arg, REBCNT part)
 /*
+**		Setup a write of the rest of an open file port. With
+**		sendfile the OS moves the data from file to socket,
+**		otherwise the file is read into a buffer first.
+**		Returns the length to send.
+**
+***********************************************************************/
+{
+	REBVAL *state = BLK_SKIP(VAL_PORT(arg), STD_PORT_STATE);
+	REBREQ *file = IS_BINARY(state) ? (REBREQ*)VAL_BIN(state) : 0;
+	REBI64 left;
+	REBCNT len;
+
+	if (!file || file->device != RDI_FILE || !IS_OPEN(file))
+		Trap1(RE_INVALID_PORT_ARG, arg);
+
+	// Write out bytes held by its write buffer, and get the size:
+	if (OS_DO_DEVICE(file, RDC_QUERY) < 0) Trap_Port(RE_WRITE_ERROR, VAL_PORT(arg), file->error);
+
+	left = file->file.size - file->file.index;
+	if (file->file.index < 0 || left < 0) left = 0; // (append mode)
+	len = (REBCNT)MIN(left, (REBI64)part);
+
+#ifdef HAS_SENDFILE
+	*OFV(port, STD_PORT_DATA) = *arg;	// keep it GC safe
+	SET_FLAG(sock->state, RSM_FILE);
+	sock->data = (REBYTE*)file;
+#else
+	{
+		REBSER *ser = Make_Binary(len);
+		Set_Binary(OFV(port, STD_PORT_DATA), ser);
+		file->data = BIN_HEAD(ser);
+		file->length = len;
+		if (OS_DO_DEVICE(file, RDC_READ) < 0) Trap_Port(RE_READ_ERROR, VAL_PORT(arg), file->error);
+		SERIES_TAIL(ser) = len = file->actual;
+		sock->data = BIN_HEAD(ser);
+	}
+#endif
+	return len;
+}
+
+
+/***********************************************************************
+**
+*/	static void Read_Datagrams(REBSER *port, REBREQ *sock, REBCNT size)
+/*
+**		Setup a read of up to UDP_BATCH datagrams of up to size
+**		bytes each. They arrive in the port data block as records
+**		of: binary, address, port-id (see Set_Datagrams).
+**
+**		The block always holds UDP_BATCH records, and its binaries
+**		are reused by each read, so steady traffic allocates
+**		nothing. A program must copy the data it keeps, as the
+**		next read overwrites it. The REBDGM array follows the
+**		request in the port state.
+**
+***********************************************************************/
+{
+	REBVAL *data = OFV(port, STD_PORT_DATA);
+	REBDGM *dgm = (REBDGM*)(sock + 1);
+	REBSER *blk;
+	REBSER *bin;
+	REBVAL *val;
+	REBCNT n;
+
+	if (size > UDP_BUF_MAX) size = UDP_BUF_MAX;
+	if (!IS_BLOCK(data) || VAL_TAIL(data) != UDP_BATCH * 3) {
+		blk = Make_Block(UDP_BATCH * 3);
+		Set_Block(data, blk);
+		for (n = 0; n < UDP_BATCH * 3; n++) SET_NONE(Append_Value(blk));
+	}
+	blk = VAL_SERIES(data);
+	VAL_INDEX(data) = SERIES_TAIL(blk); // no records until it is done
+
+	// Reuse the binaries of the last read (make them the first time):
+	for (n = 0; n < UDP_BATCH; n++, dgm++) {
+		val = BLK_SKIP(blk, n * 3);
+		if (!IS_BINARY(val) || SERIES_REST(bin = VAL_SERIES(val)) <= size) {
+			bin = Make_Binary(size);
+			Set_Binary(val, bin);
+		}
+		else if (PG_UTF8_Indexes) Free_UTF8_Index(bin); // (data is replaced)
+		VAL_INDEX(val) = 0;
+		dgm->data = BIN_HEAD(bin);
+		dgm->len = size;
+	}
+
+	sock->data = (REBYTE*)(sock + 1);
+	sock->length = UDP_BATCH;
+	sock->actual = 0;
+}
+
+
+/***********************************************************************
+**
+*/	static void Set_Datagrams(REBVAL *data, REBREQ *sock)
+/*
+**		Set the port data block to the datagrams of a finished
+**		read: each one's binary, source address (tuple, or string
+**		for IPv6), and source port-id.
+**
+**		The unused records are kept (so their binaries are too),
+**		moved before the ones that were read. The port data is
+**		positioned at the first record read.
+**
+***********************************************************************/
+{
+	REBSER *blk = VAL_SERIES(data);
+	REBDGM *dgm = (REBDGM*)(sock + 1);
+	REBVAL temp[UDP_BATCH * 3];
+	REBCNT live = sock->actual * 3;
+	REBVAL *val;
+	REBCNT n;
+
+	if (SERIES_TAIL(blk) != UDP_BATCH * 3 || live > UDP_BATCH * 3) return; // (not our block)
+
+	for (n = 0; n < sock->actual; n++, dgm++) {
+		val = BLK_SKIP(blk, n * 3);
+		VAL_TAIL(val) = dgm->len;
+		Set_Net_IP(val + 1, dgm->ipv6, (REBYTE*)&dgm->ip, dgm->ip6);
+		SET_INTEGER(val + 2, dgm->port);
+	}
+
+	// Move the records read to the end:
+	memcpy(temp, BLK_HEAD(blk), live * sizeof(REBVAL));
+	memmove(BLK_HEAD(blk), BLK_SKIP(blk, live), (UDP_BATCH * 3 - live) * sizeof(REBVAL));
+	memcpy(BLK_SKIP(blk, UDP_BATCH * 3 - live), temp, live * sizeof(REBVAL));
+	VAL_INDEX(data) = UDP_BATCH * 3 - live;
+}
+
+
+/***********************************************************************
+**
+*/	static REBCNT Write_Datagrams(REBSER *port, REBREQ *sock, REBVAL *arg)
+/*
+**		Setup a write of a datagram (binary or string), or of a
+**		block of them. In the block, a datagram may be followed by
+**		an address (tuple, or IPv6 string) and port-id to send it
+**		to, as READ gives them. Otherwise it goes to the connected
+**		host. Strings are sent as UTF-8. The data and REBDGM array
+**		are held in the port data (GC safe) until the write is
+**		done. Returns the count.
+**
+***********************************************************************/
+{
+	REBVAL *val;
+	REBSER *dgms;
+	REBSER *hold;
+	REBSER *ser;
+	REBDGM *dgm;
+	REBCNT n = 0;
+
+	if (!IS_BLOCK(arg) && !IS_BINARY(arg) && !IS_STRING(arg)) Trap1(RE_INVALID_PORT_ARG, arg);
+
+	n = (IS_BLOCK(arg) ? VAL_LEN(arg) : 1) * sizeof(REBDGM);
+	dgms = Make_Binary(n);
+	CLEAR(BIN_HEAD(dgms), n);
+	dgm = (REBDGM*)BIN_HEAD(dgms);
+
+	// Hold the data (and any UTF-8 copies) until the write is done:
+	hold = Make_Block(3);
+	Set_Block(OFV(port, STD_PORT_DATA), hold);
+	Append_Val(hold, arg);
+	Set_Binary(Append_Value(hold), dgms);
+
+	n = 0;
+	val = IS_BLOCK(arg) ? VAL_BLK_DATA(arg) : arg;
+	for (; NOT_END(val); val++, dgm++, n++) {
+		if (!IS_BINARY(val) && !IS_STRING(val)) Trap1(RE_INVALID_PORT_ARG, val);
+		if (IS_STRING(val) && NZ(ser = Encode_UTF8_Value(val, VAL_LEN(val), ENCF_NO_COPY))) {
+			Set_Binary(Append_Value(hold), ser);
+			dgm->data = BIN_HEAD(ser);
+			dgm->len = SERIES_TAIL(ser);
+		}
+		else {
+			dgm->data = VAL_BIN_DATA(val);
+			dgm->len = VAL_LEN(val);
+		}
+		if (!IS_BLOCK(arg)) {
+			n = 1;
+			break;
+		}
+
+		// Optional address and port-id:
+		if ((IS_TUPLE(val+1) || IS_STRING(val+1)) && IS_INTEGER(val+2)) {
+			if (IS_TUPLE(val+1)) {
+				if (VAL_TUPLE_LEN(val+1) != 4) Trap1(RE_INVALID_PORT_ARG, val+1);
+				memcpy(&dgm->ip, VAL_TUPLE(val+1), 4);
+			}
+			else {
+				if (!VAL_BYTE_SIZE(val+1) || !Scan_IPv6(VAL_BIN_DATA(val+1), VAL_LEN(val+1), dgm->ip6))
+					Trap1(RE_INVALID_PORT_ARG, val+1);
+				dgm->ipv6 = TRUE;
+			}
+			dgm->port = Int32s(val+2, 1);
+			if (dgm->port > 65535) Trap_Range(val+2);
+			val += 2;
+		}
+	}
+
+	sock->data = BIN_HEAD(dgms);
+	return n;
+}
+
+
+/***********************************************************************
+**
+*/	static int Net_Actor(REBVAL *ds, REBSER *port, REBCNT action, REBOOL udp)
+/*
+**		Actor for TCP and UDP ports. UDP ports transfer datagrams
+**		(see Read_Datagrams and Write_Datagrams); one opened with
+**		no host is bound to its port-id, and can read and write
+**		without a connect.
+**
 ***********************************************************************/
 {
 	REBREQ *sock;	// IO request
@@ -101,6 +473,7 @@
 	REBCNT refs;	// refinement argument flags
 	REBCNT len;		// generic length
 	REBSER *ser;	// simplifier
+	REBCNT ready;	// states that can transfer
 
 	Validate_Port(port, action);
 
@@ -108,7 +481,9 @@
 	arg = D_ARG(2);
 	refs = 0;
 
-	sock = Use_Port_State(port, RDI_NET, sizeof(*sock));
+	// A UDP port keeps its datagram array after the request:
+	sock = Use_Port_State(port, RDI_NET, sizeof(*sock) + (udp ? UDP_BATCH * sizeof(REBDGM) : 0));
+	ready = (1<<RSM_CONNECT) | (udp ? (1<<RSM_BIND) : 0);
 	//Debug_Fmt("Sock: %x", sock);
 	spec = OFV(port, STD_PORT_SPEC);
 	if (!IS_OBJECT(spec)) Trap0(RE_INVALID_PORT);
@@ -128,6 +503,10 @@
 			arg = Obj_Value(spec, STD_PORT_SPEC_NET_HOST);
 			val = Obj_Value(spec, STD_PORT_SPEC_NET_PORT_ID);
 
+			if (udp) {
+				if (!IS_NONE(arg) && !IS_INTEGER(val)) Trap_Port(RE_INVALID_SPEC, port, -10);
+				SET_FLAG(sock->modes, RST_UDP);
+			}
 			if (OS_DO_DEVICE(sock, RDC_OPEN)) Trap_Port(RE_CANNOT_OPEN, port, -12);
 			SET_OPEN(sock);
 
@@ -151,7 +530,9 @@
 			else if (IS_NONE(arg)) {
 				SET_FLAG(sock->modes, RST_LISTEN);
 				sock->data = 0; // where ACCEPT requests are queued
-				sock->net.local_port = IS_INTEGER(val) ? VAL_INT32(val) : 8000;
+				sock->net.local_port = IS_INTEGER(val) ? VAL_INT32(val) : (udp ? 0 : 8000);
+				val = Obj_Value(spec, STD_PORT_SPEC_NET_REUSE_PORT);
+				if (val && IS_TRUE(val)) SET_FLAG(sock->modes, RST_REUSE);
 				break;
 			}
 			else Trap_Port(RE_INVALID_SPEC, port, -10);
@@ -178,7 +559,10 @@
 		// This is normally called by the WAKE-UP function.
 		arg = OFV(port, STD_PORT_DATA);
 		if (sock->command == RDC_READ) {
-			if (ANY_BINSTR(arg)) VAL_TAIL(arg) += sock->actual;
+			if (udp) {
+				if (IS_BLOCK(arg)) Set_Datagrams(arg, sock);
+			}
+			else if (ANY_BINSTR(arg)) VAL_TAIL(arg) += sock->actual;
 		}
 		else if (sock->command == RDC_WRITE) {
 			SET_NONE(arg);  // Write is done.
@@ -189,20 +573,29 @@
 		// Read data into a buffer, expanding the buffer if needed.
 		// If no length is given, program must stop it at some point.
 		refs = Find_Refines(ds, ALL_READ_REFS);
-		if (!GET_FLAG(sock->state, RSM_CONNECT)) Trap_Port(RE_NOT_CONNECTED, port, -15);
+		if (!(sock->state & ready)) Trap_Port(RE_NOT_CONNECTED, port, -15);
 
-		// Setup the read buffer (allocate a buffer if needed):
-		arg = OFV(port, STD_PORT_DATA);
-		if (!IS_STRING(arg) && !IS_BINARY(arg)) {
-			Set_Binary(arg, Make_Binary(NET_BUF_SIZE));
+		// Datagrams, each in its own buffer (/part is the size):
+		if (udp) {
+			Read_Datagrams(port, sock, (refs & AM_READ_PART)
+				? Int32s(D_ARG(ARG_READ_LENGTH), 1) : UDP_BUF_SIZE);
+		}
+		else {
+			// Setup the read buffer (allocate a buffer if needed):
+			arg = OFV(port, STD_PORT_DATA);
+			if (!IS_STRING(arg) && !IS_BINARY(arg)) {
+				Set_Binary(arg, Make_Binary(NET_BUF_SIZE));
+			}
+			ser = VAL_SERIES(arg);
+			sock->length = SERIES_AVAIL(ser); // space available
+			// Grow with the data (fewer, larger reads for big transfers):
+			if (sock->length < NET_BUF_SIZE/2)
+				Extend_Series(ser, MAX(NET_BUF_SIZE, MIN(SERIES_TAIL(ser), NET_BUF_MAX)));
+			sock->length = SERIES_AVAIL(ser);
+			sock->data = STR_TAIL(ser); // write at tail
+			//if (SERIES_TAIL(ser) == 0)
+			sock->actual = 0;  // Actual for THIS read, not for total.
 		}
-		ser = VAL_SERIES(arg);
-		sock->length = SERIES_AVAIL(ser); // space available
-		if (sock->length < NET_BUF_SIZE/2) Extend_Series(ser, NET_BUF_SIZE);
-		sock->length = SERIES_AVAIL(ser);
-		sock->data = STR_TAIL(ser); // write at tail
-		//if (SERIES_TAIL(ser) == 0)
-		sock->actual = 0;  // Actual for THIS read, not for total.
 
 		//Print("(max read length %d)", sock->length);
 		result = OS_DO_DEVICE(sock, RDC_READ); // recv can happen immediately
@@ -211,23 +604,29 @@
 
 	case A_WRITE:
 		// Write the entire argument string to the network.
+		// A block of binaries is sent as one gather write, and
+		// an open file port sends the rest of its file.
 		// The lower level write code continues until done.
 
 		refs = Find_Refines(ds, ALL_WRITE_REFS);
-		if (!GET_FLAG(sock->state, RSM_CONNECT)) Trap_Port(RE_NOT_CONNECTED, port, -15);
+		if (!(sock->state & ready)) Trap_Port(RE_NOT_CONNECTED, port, -15);
 
-		// Determine length. Clip /PART to size of string if needed.
+		// Determine length. Clip /PART to size of data if needed.
 		spec = D_ARG(2);
-		len = VAL_LEN(spec);
-		if (refs & AM_WRITE_PART) {
-			REBCNT n = Int32s(D_ARG(ARG_WRITE_LENGTH), 0);
-			if (n <= len) len = n;
+		len = (refs & AM_WRITE_PART) ? Int32s(D_ARG(ARG_WRITE_LENGTH), 0) : ALL_BITS;
+		CLR_FLAG(sock->state, RSM_VECTOR);
+		CLR_FLAG(sock->state, RSM_FILE);
+
+		// Setup the write (for UDP, len is the datagram count):
+		if (udp) len = Write_Datagrams(port, sock, spec);
+		else if (IS_BLOCK(spec)) len = Write_Net_Vector(port, sock, spec, len);
+		else if (IS_PORT(spec)) len = Write_Net_File(port, sock, spec, len);
+		else {
+			if (VAL_LEN(spec) < len) len = VAL_LEN(spec);
+			*OFV(port, STD_PORT_DATA) = *spec;	// keep it GC safe
+			sock->data = VAL_BIN_DATA(spec);
 		}
-
-		// Setup the write:
-		*OFV(port, STD_PORT_DATA) = *spec;	// keep it GC safe
 		sock->length = len;
-		sock->data = VAL_BIN_DATA(spec);
 		sock->actual = 0;
 
 		//Print("(write length %d)", len);
@@ -239,7 +638,7 @@
 	case A_PICK:
 		// FIRST server-port returns new port connection.
 		len = Get_Num_Arg(arg); // Position
-		if (len == 1 && GET_FLAG(sock->modes, RST_LISTEN) && sock->data)
+		if (len == 1 && !udp && GET_FLAG(sock->modes, RST_LISTEN) && sock->data)
 			Accept_New_Port(ds, port, sock); // sets D_RET
 		else
 			Trap_Range(arg);
@@ -266,7 +665,8 @@
 
 	case A_LENGTHQ:
 		arg = OFV(port, STD_PORT_DATA);
-		len = ANY_SERIES(arg) ? VAL_TAIL(arg) : 0;
+		if (udp) len = IS_BLOCK(arg) ? VAL_LEN(arg) / 3 : 0; // datagrams read
+		else len = ANY_SERIES(arg) ? VAL_TAIL(arg) : 0;
 		SET_INTEGER(D_RET, len);
 		break;
 
@@ -279,6 +679,7 @@
 	case A_DELETE: // Temporary to TEST error handler!
 		{
 			REBVAL *event = Append_Event();		// sets signal
+			if (!event) Crash(RP_MAX_EVENTS);
 			VAL_SET(event, REB_EVENT);		// (has more space, if we need it)
 			VAL_EVENT_TYPE(event) = EVT_ERROR;
 			VAL_EVENT_DATA(event) = 101;
@@ -294,6 +695,26 @@
 }
 
 
+/***********************************************************************
+**
+*/	static int TCP_Actor(REBVAL *ds, REBSER *port, REBCNT action)
+/*
+***********************************************************************/
+{
+	return Net_Actor(ds, port, action, FALSE);
+}
+
+
+/***********************************************************************
+**
+*/	static int UDP_Actor(REBVAL *ds, REBSER *port, REBCNT action)
+/*
+***********************************************************************/
+{
+	return Net_Actor(ds, port, action, TRUE);
+}
+
+
 /***********************************************************************
 **
 */	void Init_TCP_Scheme(void)
@@ -302,3 +723,13 @@
 {
 	Register_Scheme(SYM_TCP, 0, TCP_Actor);
 }
+
+
+/***********************************************************************
+**
+*/	void Init_UDP_Scheme(void)
+/*
+***********************************************************************/
+{
+	Register_Scheme(SYM_UDP, 0, UDP_Actor);
+}
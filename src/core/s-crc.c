@@ -29,6 +29,10 @@
 
 #include "sys-core.h"
 
+#ifdef HAS_CPU_FEATURES
+#include <immintrin.h>
+#endif
+
 #define CRC_DEFINED
 
 #define CRCBITS 24			/* may be 16, 24, or 32 */
@@ -355,16 +359,26 @@ static REBCNT *CRC_Table;
 
 
 
-static u32 *crc32_table = 0;
+/***********************************************************************
+**
+**	CRC32 (as used by zlib, PNG, and Ethernet)
+**
+**		Slice-by-8 tables process eight bytes per step. Long
+**		buffers are folded 64 bytes at a time with carry-less
+**		multiply (PCLMULQDQ) when the CPU has it.
+**
+***********************************************************************/
+
+static REBCNT *crc32_table = 0;	// 8 tables of 256
 
 static void Make_CRC32_Table(void) {
-	unsigned long c;
+	REBCNT c;
 	int n,k;
 
-	crc32_table = Make_Mem(256 * sizeof(u32));
+	crc32_table = Make_Mem(8 * 256 * sizeof(REBCNT));
 
 	for(n=0;n<256;n++) {
-		c=(unsigned long)n;
+		c=(REBCNT)n;
 		for(k=0;k<8;k++) {
 			if(c&1)
 				c=0xedb88320L^(c>>1);
@@ -373,16 +387,131 @@ static void Make_CRC32_Table(void) {
 		}
 		crc32_table[n]=c;
 	}
+
+	// Table k gives the CRC of a byte followed by k zero bytes:
+	for(n=0;n<256;n++) {
+		c = crc32_table[n];
+		for(k=1;k<8;k++) {
+			c = crc32_table[c&0xff]^(c>>8);
+			crc32_table[k*256+n] = c;
+		}
+	}
 }
 
-REBCNT Update_CRC32(u32 crc, REBYTE *buf, int len) {
-	u32 c = ~crc;
-	int n;
+#ifdef HAS_CPU_FEATURES
+static REBCNT Fold_CRC32(REBCNT c, REBYTE *buf, REBCNT len) __attribute__((target("pclmul,sse4.1")));
+
+/***********************************************************************
+**
+*/	static REBCNT Fold_CRC32(REBCNT c, REBYTE *buf, REBCNT len)
+/*
+**		Fold len bytes (a multiple of 16, at least 64) into the
+**		inverted CRC c. Four 128-bit lanes are folded in parallel,
+**		then combined and Barrett reduced to 32 bits. Constants are
+**		powers of x modulo the bit-reflected CRC32 polynomial.
+**
+***********************************************************************/
+{
+	__m128i x1, x2, x3, x4, x5, x6, x7, x8;
+	__m128i k1k2 = _mm_set_epi32(0x00000001, 0xc6e41596, 0x00000001, 0x54442bd4);
+	__m128i k3k4 = _mm_set_epi32(0x00000000, 0xccaa009e, 0x00000001, 0x751997d0);
+	__m128i k5k0 = _mm_set_epi32(0x00000000, 0x00000000, 0x00000001, 0x63cd6124);
+	__m128i poly = _mm_set_epi32(0x00000001, 0xf7011641, 0x00000001, 0xdb710641);
+	__m128i mask = _mm_set_epi32(0, ~0, 0, ~0);
+
+	x1 = _mm_loadu_si128((__m128i*)(buf + 0x00));
+	x2 = _mm_loadu_si128((__m128i*)(buf + 0x10));
+	x3 = _mm_loadu_si128((__m128i*)(buf + 0x20));
+	x4 = _mm_loadu_si128((__m128i*)(buf + 0x30));
+	x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128(c));
+	buf += 64;
+	len -= 64;
+
+	for (; len >= 64; buf += 64, len -= 64) {
+		x5 = _mm_clmulepi64_si128(x1, k1k2, 0x00);
+		x6 = _mm_clmulepi64_si128(x2, k1k2, 0x00);
+		x7 = _mm_clmulepi64_si128(x3, k1k2, 0x00);
+		x8 = _mm_clmulepi64_si128(x4, k1k2, 0x00);
+		x1 = _mm_clmulepi64_si128(x1, k1k2, 0x11);
+		x2 = _mm_clmulepi64_si128(x2, k1k2, 0x11);
+		x3 = _mm_clmulepi64_si128(x3, k1k2, 0x11);
+		x4 = _mm_clmulepi64_si128(x4, k1k2, 0x11);
+		x1 = _mm_xor_si128(_mm_xor_si128(x1, x5), _mm_loadu_si128((__m128i*)(buf + 0x00)));
+		x2 = _mm_xor_si128(_mm_xor_si128(x2, x6), _mm_loadu_si128((__m128i*)(buf + 0x10)));
+		x3 = _mm_xor_si128(_mm_xor_si128(x3, x7), _mm_loadu_si128((__m128i*)(buf + 0x20)));
+		x4 = _mm_xor_si128(_mm_xor_si128(x4, x8), _mm_loadu_si128((__m128i*)(buf + 0x30)));
+	}
+
+	// Fold the four lanes into one, then any remaining 16 byte blocks:
+	x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+	x1 = _mm_clmulepi64_si128(x1, k3k4, 0x11);
+	x1 = _mm_xor_si128(_mm_xor_si128(x1, x2), x5);
+	x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+	x1 = _mm_clmulepi64_si128(x1, k3k4, 0x11);
+	x1 = _mm_xor_si128(_mm_xor_si128(x1, x3), x5);
+	x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+	x1 = _mm_clmulepi64_si128(x1, k3k4, 0x11);
+	x1 = _mm_xor_si128(_mm_xor_si128(x1, x4), x5);
+
+	for (; len >= 16; buf += 16, len -= 16) {
+		x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+		x1 = _mm_clmulepi64_si128(x1, k3k4, 0x11);
+		x1 = _mm_xor_si128(_mm_xor_si128(x1, _mm_loadu_si128((__m128i*)buf)), x5);
+	}
+
+	// Fold 128 bits to 64:
+	x2 = _mm_clmulepi64_si128(x1, k3k4, 0x10);
+	x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2);
+	x2 = _mm_srli_si128(x1, 4);
+	x1 = _mm_and_si128(x1, mask);
+	x1 = _mm_clmulepi64_si128(x1, k5k0, 0x00);
+	x1 = _mm_xor_si128(x1, x2);
+
+	// Barrett reduce to 32 bits:
+	x2 = _mm_and_si128(x1, mask);
+	x2 = _mm_clmulepi64_si128(x2, poly, 0x10);
+	x2 = _mm_and_si128(x2, mask);
+	x2 = _mm_clmulepi64_si128(x2, poly, 0x00);
+	x1 = _mm_xor_si128(x1, x2);
+
+	return (REBCNT)_mm_extract_epi32(x1, 1);
+}
+#endif
+
+/***********************************************************************
+**
+*/	REBCNT Update_CRC32(u32 crc, REBYTE *buf, int len)
+/*
+**		Continue a CRC32 checksum (start with zero).
+**
+***********************************************************************/
+{
+	REBCNT c = ~(REBCNT)crc;
+	REBCNT h;
+	REBCNT *t;
 
 	if(!crc32_table) Make_CRC32_Table();
+	t = crc32_table;
+
+#ifdef HAS_CPU_FEATURES
+	if (len >= 64 && (CPU_Features() & CPU_PCLMUL)) {
+		c = Fold_CRC32(c, buf, len & ~15);
+		buf += len & ~15;
+		len &= 15;
+	}
+#endif
+
+	for (; len >= 8; buf += 8, len -= 8) {
+		c ^= buf[0] | (buf[1] << 8) | (buf[2] << 16) | ((REBCNT)buf[3] << 24);
+		h  = buf[4] | (buf[5] << 8) | (buf[6] << 16) | ((REBCNT)buf[7] << 24);
+		c = t[7*256 + (c & 0xff)] ^ t[6*256 + ((c >> 8) & 0xff)]
+		  ^ t[5*256 + ((c >> 16) & 0xff)] ^ t[4*256 + (c >> 24)]
+		  ^ t[3*256 + (h & 0xff)] ^ t[2*256 + ((h >> 8) & 0xff)]
+		  ^ t[1*256 + ((h >> 16) & 0xff)] ^ t[h >> 24];
+	}
 
-	for(n = 0; n < len; n++)
-		c = crc32_table[(c^buf[n])&0xff]^(c>>8);
+	for (; len > 0; len--)
+		c = t[(c ^ *buf++) & 0xff] ^ (c >> 8);
 
 	return ~c;
 }
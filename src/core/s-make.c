@@ -101,9 +101,7 @@
 	dst = UNI_HEAD(series);
 	SERIES_TAIL(series) = len;
 
-	for (; len > 0; len--) {
-		*dst++ = (REBUNI)(*src++);
-	}
+	Widen_Bytes(dst, src, len);
 
 	UNI_TERM(series);
 
@@ -164,14 +162,13 @@
 	REBSER *uni = Make_Unicode(STR_LEN(series));
 	REBUNI *up;
 	REBYTE *bp;
-	REBCNT n;
 	REBSER tmp;
 
 	// !!! optimize the empty case by just modifying series header??
 
 	bp = BIN_HEAD(series);
 	up = UNI_HEAD(uni);
-	for (n = 0; n < STR_LEN(series); n++) up[n] = bp[n];
+	Widen_Bytes(up, bp, STR_LEN(series));
 	SERIES_TAIL(uni) = SERIES_TAIL(series);
 
 	// Swap series headers: // !!?? is it valid for all?
@@ -407,8 +404,8 @@ x*/	REBCNT Insert_Value(REBSER *series, REBCNT index, REBVAL *item, REBCNT type,
 	}
 	else {
 		up = UNI_SKIP(dst, tail);
-		for (; len > 0; len--) *up++ = (REBUNI)*src++;
-		*up = 0;
+		Widen_Bytes(up, src, len);
+		up[len] = 0;
 	}
 
 	return dst;
@@ -582,6 +579,9 @@ x*/	REBCNT Insert_Value(REBSER *series, REBCNT index, REBVAL *item, REBCNT type,
 
 	if (len < 0) len = LEN_BYTES(src);
 
+	// All ASCII needs no decoding:
+	if (Skip_ASCII(src, len, 0) == (REBCNT)len) return Append_Bytes_Len(dst, src, len);
+
 	Resize_Series(ser, len+1); // needs at most this much
 
 	len = Decode_UTF8(UNI_HEAD(ser), src, len, FALSE);
@@ -595,6 +595,7 @@ x*/	REBCNT Insert_Value(REBSER *series, REBCNT index, REBVAL *item, REBCNT type,
 		}
 	} else {
 		if (!dst) dst = Make_Unicode(len);
+		else if (BYTE_SIZE(dst)) Widen_String(dst);
 	}
 
 	Append_Uni_Uni(dst, UNI_HEAD(ser), len);
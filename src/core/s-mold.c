@@ -83,8 +83,6 @@ enum {
 	REBYTE ender = 0;
 	REBSER *series = mold->series;
 
-	ASSERT2(SERIES_WIDE(series) ==2, 9997);
-
 	va_start(args, fmt);
 
 	for (; *fmt; fmt++) {
@@ -180,16 +178,84 @@ enum {
 **
 */  REBUNI *Prep_Uni_Series(REB_MOLD *mold, REBCNT len)
 /*
+**		Widens a byte mold buffer, as the caller writes unicode.
+**
 ***********************************************************************/
 {
 	REBCNT tail = SERIES_TAIL(mold->series);
 
+	if (BYTE_SIZE(mold->series)) Widen_String(mold->series);
+
 	EXPAND_SERIES_TAIL(mold->series, len);
 
 	return UNI_SKIP(mold->series, tail);
 }
 
 
+/***********************************************************************
+**
+*/  static REBYTE *Prep_Byte_Series(REB_MOLD *mold, REBCNT len)
+/*
+**		Caller must check that the mold buffer is byte sized.
+**
+***********************************************************************/
+{
+	REBCNT tail = SERIES_TAIL(mold->series);
+
+	EXPAND_SERIES_TAIL(mold->series, len);
+
+	return BIN_SKIP(mold->series, tail);
+}
+
+
+/***********************************************************************
+**
+*/  void Flush_Mold(REB_MOLD *mold, REBFLG all)
+/*
+**		Streaming mold: encode the mold buffer as UTF-8 and pass
+**		it to the output function, then reset the buffer.
+**
+**		Unless all is set, the last char is kept in the buffer, as
+**		separators and new lines check for it. Only called by the
+**		outermost Form_Block_Series between its values, as nested
+**		molds may hold start indexes into the buffer.
+**
+**		The encoding goes into the shared form buffer, and the mold
+**		buffer keeps its memory, so no series is made per chunk.
+**
+***********************************************************************/
+{
+	REBSER *ser = mold->series;
+	REBCNT len = SERIES_TAIL(ser);
+	REBCNT keep = 0;
+	REBFLG uni = !BYTE_SIZE(ser);
+	REBFLG ccr = ENCF_OS_CRLF != 0;
+	REBCNT size;
+	REBYTE *dp;
+
+	if (!mold->flush || len == 0) return;
+
+	if (!all) keep = GET_ANY_CHAR(ser, --len);
+
+	if (!uni && !ccr && !Is_Not_ASCII(BIN_HEAD(ser), len))
+		mold->flush(mold->out, BIN_HEAD(ser), len);
+	else {
+		size = Length_As_UTF8((REBUNI*)SERIES_DATA(ser), len, (REBOOL)uni, (REBOOL)ccr);
+		dp = Reset_Buffer(BUF_FORM, size);
+		Encode_UTF8(dp, size, SERIES_DATA(ser), &len, uni, ccr);
+		mold->flush(mold->out, dp, len);
+	}
+
+	RESET_TAIL(ser);
+
+	// Return to byte size once the wide content is gone:
+	if (GET_MOPT(mold, MOPT_BYTES) && uni && keep <= 0xFF) Narrow_Series(ser);
+
+	if (!all) Append_Byte(ser, keep); // (either width)
+	else TERM_SERIES(ser);
+}
+
+
 /***********************************************************************
 ************************************************************************
 **
@@ -247,18 +313,15 @@ enum {
 **
 ***********************************************************************/
 {
+	REBSER *ser = mold->series;
 	REBINT n;
-	REBUNI *cp = 0;
 
 	// Check output string has content already but no terminator:
-	if (mold->series->tail) {
-		cp = UNI_LAST(mold->series);
-		if (*cp == ' ' || *cp == '\t') *cp = '\n';
-		else cp = 0;
+	n = ser->tail ? GET_ANY_CHAR(ser, ser->tail - 1) : 0;
+	if (n == ' ' || n == '\t') {
+		SET_ANY_CHAR(ser, ser->tail - 1, '\n');
 	}
-
-	// Add terminator:
-	if (!cp) Append_Byte(mold->series, '\n');
+	else Append_Byte(ser, '\n'); // Add terminator
 
 	// Add proper indentation:
 	if (!GET_MOPT(mold, MOPT_INDENT)) {
@@ -344,10 +407,51 @@ static REBUNI *Emit_Uni_Char(REBUNI *up, REBUNI chr, REBOOL parened)
 	return up;
 }
 
+static REBYTE *Emit_Byte_Char(REBYTE *bp, REBYTE chr, REBOOL parened)
+{
+	// Same as above for byte sized output:
+	if (chr >= 0x7f || chr == 0x1e) {
+		if (parened || chr == 0x1e) {
+			*bp++ = '^';
+			*bp++ = '(';
+			if (chr >= 0x10) *bp++ = Hex_Digits[chr >> 4];
+			*bp++ = Hex_Digits[chr & 0xf];
+			*bp++ = ')';
+			return bp;
+		}
+	}
+	else if (IS_CHR_ESC(chr)) {
+		*bp++ = '^';
+		*bp++ = Char_Escapes[chr];
+		return bp;
+	}
+
+	*bp++ = chr;
+	return bp;
+}
+
 STOID Mold_Uni_Char(REBSER *dst, REBUNI chr, REBOOL molded, REBOOL parened)
 {
 	REBCNT tail = SERIES_TAIL(dst);
 	REBUNI *up;
+	REBUNI buf[10];
+
+	if (BYTE_SIZE(dst)) {
+		if (chr > 0xFF) Widen_String(dst);
+		else {
+			// Result is never wider than the char:
+			if (!molded) Append_Byte(dst, chr);
+			else {
+				up = buf;
+				*up++ = '#';
+				*up++ = '"';
+				up = Emit_Uni_Char(up, chr, parened);
+				*up++ = '"';
+				Append_Uni_Bytes(dst, buf, up - buf);
+			}
+			return;
+		}
+	}
 
 	if (!molded) {
 		EXPAND_SERIES_TAIL(dst, 1);
@@ -365,6 +469,57 @@ STOID Mold_Uni_Char(REBSER *dst, REBUNI chr, REBOOL molded, REBOOL parened)
 	UNI_TERM(dst);
 }
 
+STOID Mold_Byte_String(REBYTE *bp, REBCNT idx, REBCNT tail, REB_STRF *sf, REB_MOLD *mold)
+{
+	// Same as Mold_String_Series (below), for byte source and output.
+	REBOOL parened = (REBOOL)GET_MOPT(mold, MOPT_ANSI_ONLY);
+	REBCNT len = tail - idx;
+	REBYTE *dp;
+	REBCNT n;
+	REBYTE c;
+
+	// If it is a short quoted string, emit it as "string":
+	if (len <= MAX_QUOTED_STR && sf->quote == 0 && sf->newline < 3) {
+
+		dp = Prep_Byte_Series(mold, len + sf->newline + sf->escape + sf->paren + sf->chr1e + 2);
+
+		*dp++ = '"';
+		for (n = idx; n < tail; n++) dp = Emit_Byte_Char(dp, bp[n], parened);
+		*dp++ = '"';
+		*dp = 0;
+		return;
+	}
+
+	// It is a braced string, emit it as {string}:
+	if (!sf->malign) sf->brace_in = sf->brace_out = 0;
+
+	dp = Prep_Byte_Series(mold, len + sf->brace_in + sf->brace_out + sf->escape + sf->paren + sf->chr1e + 2);
+
+	*dp++ = '{';
+
+	for (n = idx; n < tail; n++) {
+		c = bp[n];
+		switch (c) {
+		case '{':
+		case '}':
+			if (sf->malign) {
+				*dp++ = '^';
+				*dp++ = c;
+				break;
+			}
+		case '\n':
+		case '"':
+			*dp++ = c;
+			break;
+		default:
+			dp = Emit_Byte_Char(dp, c, parened);
+		}
+	}
+
+	*dp++ = '}';
+	*dp = 0;
+}
+
 STOID Mold_String_Series(REBVAL *value, REB_MOLD *mold)
 {
 	REBCNT len = VAL_LEN(value);
@@ -391,6 +546,12 @@ STOID Mold_String_Series(REBVAL *value, REB_MOLD *mold)
 	if (uni) up = UNI_HEAD(ser);
 	else bp = STR_HEAD(ser);
 
+	// Byte source into byte buffer:
+	if (!uni && BYTE_SIZE(mold->series)) {
+		Mold_Byte_String(bp, idx, VAL_TAIL(value), &sf, mold);
+		return;
+	}
+
 	// If it is a short quoted string, emit it as "string":
 	if (len <= MAX_QUOTED_STR && sf.quote == 0 && sf.newline < 3) {
 
@@ -472,6 +633,7 @@ STOID Mold_Issue(REBVAL *value, REB_MOLD *mold)
 STOID Mold_Url(REBVAL *value, REB_MOLD *mold)
 {
 	REBUNI *dp;
+	REBYTE *bp;
 	REBCNT n;
 	REBUNI c;
 	REBCNT len = VAL_LEN(value);
@@ -483,6 +645,20 @@ STOID Mold_Url(REBVAL *value, REB_MOLD *mold)
 		if (IS_URL_ESC(c)) len += 2;
 	}
 
+	if (BYTE_SIZE(ser) && BYTE_SIZE(mold->series)) {
+		bp = Prep_Byte_Series(mold, len);
+		for (n = VAL_INDEX(value); n < VAL_TAIL(value); n++) {
+			c = BIN_HEAD(ser)[n];
+			if (IS_URL_ESC(c)) {
+				*bp++ = '%';
+				bp = Form_Hex2(bp, c);  // c => %xx
+			}
+			else *bp++ = (REBYTE)c;
+		}
+		*bp = 0;
+		return;
+	}
+
 	dp = Prep_Uni_Series(mold, len);
 
 	for (n = VAL_INDEX(value); n < VAL_TAIL(value); n++) {
@@ -497,6 +673,7 @@ STOID Mold_Url(REBVAL *value, REB_MOLD *mold)
 STOID Mold_File(REBVAL *value, REB_MOLD *mold)
 {
 	REBUNI *dp;
+	REBYTE *bp;
 	REBCNT n;
 	REBUNI c;
 	REBCNT len = VAL_LEN(value);
@@ -510,6 +687,22 @@ STOID Mold_File(REBVAL *value, REB_MOLD *mold)
 
 	len++; // room for % at start
 
+	if (BYTE_SIZE(ser) && BYTE_SIZE(mold->series)) {
+		bp = Prep_Byte_Series(mold, len);
+		*bp++ = '%';
+
+		for (n = VAL_INDEX(value); n < VAL_TAIL(value); n++) {
+			c = BIN_HEAD(ser)[n];
+			if (IS_FILE_ESC(c)) {
+				*bp++ = '%';
+				bp = Form_Hex2(bp, c);  // c => %xx
+			}
+			else *bp++ = (REBYTE)c;
+		}
+		*bp = 0;
+		return;
+	}
+
 	dp = Prep_Uni_Series(mold, len);
 
 	*dp++ = '%';
@@ -731,9 +924,14 @@ STOID Form_Block_Series(REBSER *blk, REBCNT index, REB_MOLD *mold, REBSER *frame
 	REBINT len = SERIES_TAIL(blk) - index;
 	REBVAL *val;
 	REBVAL *wval;
+	void (*flush)(void *, REBYTE *, REBCNT) = mold->flush;
 
 	if (len < 0) len = 0;
 
+	// Only this (outermost) loop flushes a streaming mold. Nested
+	// molds may hold start indexes into the buffer (see Flush_Mold):
+	mold->flush = 0;
+
 	for (n = 0; n < len;) {
 		val = BLK_SKIP(blk, index+n);
 		wval = 0;
@@ -742,6 +940,11 @@ STOID Form_Block_Series(REBSER *blk, REBCNT index, REB_MOLD *mold, REBSER *frame
 			if (wval) val = wval;
 		}
 		Mold_Value(mold, val, wval != 0);
+		if (flush && SERIES_TAIL(mold->series) >= MOLD_CHUNK) {
+			mold->flush = flush;
+			Flush_Mold(mold, FALSE);
+			mold->flush = 0;
+		}
 		n++;
 		if (GET_MOPT(mold, MOPT_LINES)) {
 			Append_Byte(mold->series, LF);
@@ -749,12 +952,14 @@ STOID Form_Block_Series(REBSER *blk, REBCNT index, REB_MOLD *mold, REBSER *frame
 		else {
 			// Add a space if needed:
 			if (n < len && mold->series->tail
-				&& *UNI_LAST(mold->series) != LF
+				&& GET_ANY_CHAR(mold->series, mold->series->tail - 1) != LF
 				&& !GET_MOPT(mold, MOPT_TIGHT)
 			)
 				Append_Byte(mold->series, ' ');
 		}
 	}
+
+	mold->flush = flush;
 }
 
 
@@ -1018,7 +1223,6 @@ STOID Mold_Error(REBVAL *value, REB_MOLD *mold, REBFLG molded)
 
 	CHECK_STACK(&len);
 
-	ASSERT2(SERIES_WIDE(mold->series) == sizeof(REBUNI), RP_BAD_SIZE);
 	ASSERT2(ser, RP_NO_BUFFER);
 
 	// Special handling of string series: {
@@ -1283,7 +1487,7 @@ append:
 {
 	REB_MOLD mo = {0};
 
-	mo.opts = opts;
+	mo.opts = opts | (1 << MOPT_BYTES);
 	Reset_Mold(&mo);
 	Mold_Value(&mo, value, 0);
 	return Copy_String(mo.series, 0, -1);
@@ -1300,7 +1504,7 @@ append:
 {
 	REB_MOLD mo = {0};
 
-	mo.opts = opts;
+	mo.opts = opts | (1 << MOPT_BYTES);
 	Reset_Mold(&mo);
 	Mold_Value(&mo, value, TRUE);
 	return Copy_String(mo.series, 0, -1);
@@ -1321,6 +1525,7 @@ append:
 		index = Do_Next(block, index, 0);
 	}
 
+	SET_FLAG(mo.opts, MOPT_BYTES);
 	Reset_Mold(&mo);
 
 	for (n = start; n <= DSP; n++)
@@ -1341,6 +1546,7 @@ append:
 	REB_MOLD mo = {0};
 	REBVAL *val;
 
+	SET_FLAG(mo.opts, MOPT_BYTES);
 	Reset_Mold(&mo);
 	for (val = VAL_BLK_DATA(blk); NOT_END(val); val++)
 		Mold_Value(&mo, val, 0);
@@ -1357,6 +1563,15 @@ append:
 	REBSER *buf = BUF_MOLD;
 	REBINT len;
 
+	if (GET_MOPT(mold, MOPT_BYTES)) {
+		// Byte buffer may have been widened by the prior mold:
+		buf = BUF_MOLD8;
+		if (buf && !BYTE_SIZE(buf)) {
+			buf = Make_Binary(MIN_COMMON);
+			Set_Root_Series(TASK_BUF_MOLD8, buf, "byte mold buffer");
+		}
+	}
+
 	if (!buf) Crash(RP_NO_BUFFER);
 
 	if (SERIES_REST(buf) > MAX_COMMON)
@@ -1415,6 +1630,7 @@ append:
 
 	Set_Root_Series(TASK_MOLD_LOOP, Make_Block(size/10), "mold loop");
 	Set_Root_Series(TASK_BUF_MOLD, Make_Unicode(size), "mold buffer");
+	Set_Root_Series(TASK_BUF_MOLD8, Make_Binary(size), "byte mold buffer");
 
 	// Create quoted char escape table:
 	Char_Escapes = cp = Make_Mem(MAX_ESC_CHAR+1); // cleared
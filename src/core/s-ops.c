@@ -39,10 +39,7 @@
 **
 ***********************************************************************/
 {
-	for (; len > 0; len--, bp++)
-		if (*bp >= 0x80) return TRUE;
-
-	return FALSE;
+	return Skip_ASCII(bp, len, 0) < len;
 }
 
 
@@ -704,6 +701,7 @@ static REBYTE seed_str[SEED_LEN] = {
 	// String series:
 
 	if (IS_PROTECT_SERIES(VAL_SERIES(val))) Trap0(RE_PROTECTED);
+	if (PG_UTF8_Indexes) Free_UTF8_Index(VAL_SERIES(val));
 
 	len = Partial(val, 0, part, 0);
 	n = VAL_INDEX(val);
@@ -112,6 +112,13 @@
 
 #include "sys-core.h"
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
 
 /* ---------------------------------------------------------------------
 	The following 4 definitions are compiler-specific.
@@ -703,6 +710,149 @@ ConversionResult ConvertUTF8toUTF32 (
 ************************************************************************
 ***********************************************************************/
 
+/***********************************************************************
+**
+*/	REBCNT Skip_ASCII(REBYTE *bp, REBCNT len, REBYTE stop)
+/*
+**		Returns the number of leading ASCII bytes (below 0x80).
+**		If stop is not zero, the run also ends at that char (CR or LF).
+**
+**		This is the fast path for text input, which is mostly ASCII:
+**		it checks 16 or 32 bytes per step with SSE2 or AVX2, and 8
+**		bytes per step (as a 64 bit word) otherwise.
+**
+***********************************************************************/
+{
+	REBCNT n = 0;
+
+#if defined(__AVX2__)
+	{
+		__m256i sc = _mm256_set1_epi8(stop);
+		__m256i x;
+		for (; n + 32 <= len; n += 32) {
+			x = _mm256_loadu_si256((__m256i*)(bp + n));
+			if (_mm256_movemask_epi8(x)) break;
+			if (stop && _mm256_movemask_epi8(_mm256_cmpeq_epi8(x, sc))) break;
+		}
+	}
+#endif
+#if defined(__SSE2__)
+	{
+		__m128i sc = _mm_set1_epi8(stop);
+		__m128i x;
+		for (; n + 16 <= len; n += 16) {
+			x = _mm_loadu_si128((__m128i*)(bp + n));
+			if (_mm_movemask_epi8(x)) break;
+			if (stop && _mm_movemask_epi8(_mm_cmpeq_epi8(x, sc))) break;
+		}
+	}
+#else
+	{
+		REBU64 w;
+		REBU64 c;
+		const REBU64 ones = (REBU64)0x01010101 << 32 | 0x01010101;
+		const REBU64 high = ones * 0x80;
+		for (; n + 8 <= len; n += 8) {
+			memcpy(&w, bp + n, 8); // (unaligned load)
+			if (w & high) break;
+			if (stop) {
+				c = w ^ (ones * stop); // zero byte where stop char was
+				if ((c - ones) & ~c & high) break;
+			}
+		}
+	}
+#endif
+
+	// Finish (or find the exact stop in the last block):
+	for (; n < len; n++) {
+		if (bp[n] >= 0x80 || (stop && bp[n] == stop)) break;
+	}
+
+	return n;
+}
+
+
+/***********************************************************************
+**
+*/	REBCNT Skip_ASCII_Uni(REBUNI *up, REBCNT len, REBUNI stop)
+/*
+**		Same as above, for unicode chars.
+**
+***********************************************************************/
+{
+	REBCNT n = 0;
+
+#if defined(__SSE2__)
+	{
+		__m128i mask = _mm_set1_epi16((short)0xff80);
+		__m128i sc = _mm_set1_epi16(stop);
+		__m128i zero = _mm_setzero_si128();
+		__m128i x;
+		for (; n + 8 <= len; n += 8) {
+			x = _mm_loadu_si128((__m128i*)(up + n));
+			if (_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(x, mask), zero)) != 0xffff) break;
+			if (stop && _mm_movemask_epi8(_mm_cmpeq_epi16(x, sc))) break;
+		}
+	}
+#endif
+
+	for (; n < len; n++) {
+		if (up[n] >= 0x80 || (stop && up[n] == stop)) break;
+	}
+
+	return n;
+}
+
+
+/***********************************************************************
+**
+*/	void Widen_Bytes(REBUNI *dst, REBYTE *src, REBCNT len)
+/*
+**		Copy bytes (latin-1) to unicode chars.
+**
+***********************************************************************/
+{
+	REBCNT n = 0;
+
+#if defined(__SSE2__)
+	{
+		__m128i zero = _mm_setzero_si128();
+		__m128i x;
+		for (; n + 16 <= len; n += 16) {
+			x = _mm_loadu_si128((__m128i*)(src + n));
+			_mm_storeu_si128((__m128i*)(dst + n), _mm_unpacklo_epi8(x, zero));
+			_mm_storeu_si128((__m128i*)(dst + n + 8), _mm_unpackhi_epi8(x, zero));
+		}
+	}
+#endif
+
+	for (; n < len; n++) dst[n] = src[n];
+}
+
+
+/***********************************************************************
+**
+*/	void Narrow_Uni(REBYTE *dst, REBUNI *src, REBCNT len)
+/*
+**		Copy unicode chars to bytes. All chars must be below 0x100.
+**
+***********************************************************************/
+{
+	REBCNT n = 0;
+
+#if defined(__SSE2__)
+	for (; n + 16 <= len; n += 16) {
+		_mm_storeu_si128((__m128i*)(dst + n), _mm_packus_epi16(
+			_mm_loadu_si128((__m128i*)(src + n)),
+			_mm_loadu_si128((__m128i*)(src + n + 8))
+		));
+	}
+#endif
+
+	for (; n < len; n++) dst[n] = (REBYTE)src[n];
+}
+
+
 /***********************************************************************
 **
 */	REBINT What_UTF(REBYTE *bp, REBCNT len)
@@ -758,6 +908,11 @@ ConversionResult ConvertUTF8toUTF32 (
 	REBYTE *end = str + len;
 
 	for (;str < end; str += n) {
+		if (*str < 0x80) {
+			// Skip the whole ASCII run:
+			str += Skip_ASCII(str, end - str, 0);
+			if (str >= end) break;
+		}
 		n = trailingBytesForUTF8[*str] + 1;
 		if (str + n > end || !isLegalUTF8(str, n)) return str;
 	}
@@ -766,6 +921,223 @@ ConversionResult ConvertUTF8toUTF32 (
 }
 
 
+/***********************************************************************
+**
+*/	REBCNT Length_UTF8_Chars(REBYTE *bp, REBCNT len)
+/*
+**		Returns the number of chars in UTF-8 data (the bytes that are
+**		not 10xxxxxx continuation bytes). Does not validate.
+**
+***********************************************************************/
+{
+	REBCNT count = len;
+	REBCNT n = 0;
+
+#if defined(__SSE2__)
+	{
+		__m128i zero = _mm_setzero_si128();
+		__m128i c0 = _mm_set1_epi8((char)0xC0);
+		__m128i acc;
+		REBCNT end;
+		while (n + 16 <= len) {
+			// Byte lanes count up by at most 1 per step:
+			end = n + MIN((len - n) & ~15, 16 * 255);
+			acc = zero;
+			for (; n < end; n += 16) {
+				// Continuation bytes are the signed values below 0xC0:
+				acc = _mm_sub_epi8(acc, _mm_cmplt_epi8(_mm_loadu_si128((__m128i*)(bp + n)), c0));
+			}
+			acc = _mm_sad_epu8(acc, zero);
+			count -= _mm_cvtsi128_si32(acc) + _mm_cvtsi128_si32(_mm_srli_si128(acc, 8));
+		}
+	}
+#endif
+
+	for (; n < len; n++) {
+		if ((bp[n] & 0xC0) == 0x80) count--;
+	}
+
+	return count;
+}
+
+
+// Index tables of UTF-8 binaries (see Seek_UTF8):
+typedef struct rebol_utf8_index {
+	struct rebol_utf8_index *next;
+	REBSER *series;	// binary that is indexed
+	REBYTE *data;	// its data and tail when indexed (to check it)
+	REBCNT tail;
+	REBCNT chars;	// chars in the binary
+	REBCNT size;	// entries allocated in table
+	REBCNT *table;	// byte offset of every UTF8_INDEX_STEP-th char
+} REBUIX;
+
+static REBUIX *UTF8_Indexes;
+
+
+/***********************************************************************
+**
+*/	static void Drop_UTF8_Index(REBUIX **prior)
+/*
+**		Unlink and free an index table.
+**
+***********************************************************************/
+{
+	REBUIX *uix = *prior;
+
+	*prior = uix->next;
+	Free_Mem(uix->table, uix->size * sizeof(REBCNT));
+	Free_Mem(uix, sizeof(REBUIX));
+	PG_UTF8_Indexes--;
+}
+
+
+/***********************************************************************
+**
+*/	void Free_UTF8_Index(REBSER *series)
+/*
+**		Forget the index table of a binary. Called when the series
+**		is freed, and before anything modifies its data in place:
+**		the series actions, path set, Modify_String (PARSE),
+**		Remove_Series, ENCLOAK/DECLOAK, RL_Set_Char, commands,
+**		vector views, and UDP reads that reuse it. The table of a
+**		binary is kept as long as none of these touch it.
+**
+***********************************************************************/
+{
+	REBUIX **prior;
+
+	for (prior = &UTF8_Indexes; *prior; prior = &(*prior)->next) {
+		if ((*prior)->series == series) {
+			Drop_UTF8_Index(prior);
+			return;
+		}
+	}
+}
+
+
+/***********************************************************************
+**
+*/	static REBUIX *Get_UTF8_Index(REBSER *series)
+/*
+**		Return the index table of a UTF-8 binary, making it if the
+**		binary has none or if its data has moved or changed length.
+**		The most recently used tables are kept (MAX_UTF8_INDEXES).
+**
+***********************************************************************/
+{
+	REBUIX **prior;
+	REBUIX *uix;
+	REBYTE *bp = BIN_HEAD(series);
+	REBCNT len = SERIES_TAIL(series);
+	REBCNT *idx;
+	REBCNT n;
+	REBCNT chr = 0;
+
+	for (prior = &UTF8_Indexes; NZ(uix = *prior); prior = &uix->next) {
+		if (uix->series != series) continue;
+		if (uix->data == bp && uix->tail == len) {
+			// Move it to the front of the list:
+			*prior = uix->next;
+			uix->next = UTF8_Indexes;
+			UTF8_Indexes = uix;
+			return uix;
+		}
+		Drop_UTF8_Index(prior);
+		break;
+	}
+
+	if (PG_UTF8_Indexes >= MAX_UTF8_INDEXES) {
+		for (prior = &UTF8_Indexes; (*prior)->next; prior = &(*prior)->next);
+		Drop_UTF8_Index(prior);
+	}
+
+	uix = Make_Mem(sizeof(REBUIX));
+	if (!uix) Trap0(RE_NO_MEMORY);
+	uix->size = len / UTF8_INDEX_STEP + 1;
+	uix->table = Make_Mem(uix->size * sizeof(REBCNT));
+	if (!uix->table) {
+		Free_Mem(uix, sizeof(REBUIX));
+		Trap0(RE_NO_MEMORY);
+	}
+	uix->series = series;
+	uix->data = bp;
+	uix->tail = len;
+
+	idx = uix->table;
+	for (n = 0; n < len; n++) {
+		if ((bp[n] & 0xC0) != 0x80) {
+			if (!(chr % UTF8_INDEX_STEP)) *idx++ = n;
+			chr++;
+		}
+	}
+	uix->chars = chr;
+
+	uix->next = UTF8_Indexes;
+	UTF8_Indexes = uix;
+	PG_UTF8_Indexes++;
+
+	return uix;
+}
+
+
+/***********************************************************************
+**
+*/	static REBCNT Skip_UTF8(REBYTE *bp, REBCNT n, REBCNT len, REBCNT chr)
+/*
+**		Returns the byte offset that is chr chars after offset n.
+**
+***********************************************************************/
+{
+	for (; chr > 0 && n < len; chr--) {
+		// Skip the char and its continuation bytes:
+		for (n++; n < len && (bp[n] & 0xC0) == 0x80; n++);
+	}
+	return n;
+}
+
+
+/***********************************************************************
+**
+*/	REBCNT Seek_UTF8(REBSER *series, REBCNT index, REBCNT chr)
+/*
+**		Returns the byte offset (from the head) of the char that is
+**		chr chars after byte offset index of a UTF-8 binary. Offsets
+**		past the end return the tail.
+**
+**		Short seeks just scan the data. Longer ones use the index
+**		table of the binary, which is kept between calls, so they
+**		cost a binary search and a scan of at most one table step.
+**
+***********************************************************************/
+{
+	REBYTE *bp = BIN_HEAD(series);
+	REBCNT len = SERIES_TAIL(series);
+	REBUIX *uix;
+	REBCNT lo, hi, mid;
+
+	if (index >= len) return len;
+	if (chr < UTF8_INDEX_STEP) return Skip_UTF8(bp, index, len, chr);
+
+	uix = Get_UTF8_Index(series);
+
+	// Find the char number of index (last entry at or below it):
+	lo = 0;
+	hi = (uix->chars + UTF8_INDEX_STEP - 1) / UTF8_INDEX_STEP;
+	while (hi - lo > 1) {
+		mid = (lo + hi) / 2;
+		if (uix->table[mid] <= index) lo = mid; else hi = mid;
+	}
+	for (mid = uix->table[lo], hi = lo * UTF8_INDEX_STEP; mid < index; hi++)
+		mid = Skip_UTF8(bp, mid, len, 1);
+	if (mid > index) hi--; // (index is inside a char)
+
+	chr += hi;
+	if (chr >= uix->chars) return len;
+	return Skip_UTF8(bp, uix->table[chr / UTF8_INDEX_STEP], len, chr % UTF8_INDEX_STEP);
+}
+
+
 /***********************************************************************
 **
 */	REBCNT Decode_UTF8_Char(REBYTE **str, REBINT *len)
@@ -834,9 +1206,19 @@ ConversionResult ConvertUTF8toUTF32 (
 	int flag = -1;
 	UTF32 ch;
 	REBUNI *start = dst;
+	REBCNT n;
 
 	for (; len > 0; len--, src++) {
-		if ((ch = *src) >= 0x80) {
+		if ((ch = *src) < 0x80 && !(ch == CR && ccr)) {
+			// Copy the whole ASCII run (up to next CR if converting):
+			n = Skip_ASCII(src, len, ccr ? CR : 0);
+			Widen_Bytes(dst, src, n);
+			dst += n;
+			src += n - 1;
+			len -= n - 1;
+			continue;
+		}
+		if (ch >= 0x80) {
 			ch = Decode_UTF8_Char(&src, &len);
 			if (ch == 0) ch = UNI_REPLACEMENT_CHAR; // temporary!
 			if (ch > 0xff) flag = 1;
@@ -939,6 +1321,8 @@ ConversionResult ConvertUTF8toUTF32 (
 	}
 
 	if (utf == 0 || utf == 8) {
+		// All ASCII (and no CR to convert) is already the result:
+		if (Skip_ASCII(bp, len, CR) == len) return Copy_Bytes(bp, len);
 		size = Decode_UTF8((REBUNI*)Reset_Buffer(ser, len), bp, len, TRUE);
 	} 
 	else if (utf == -16 || utf == 16) {
@@ -968,24 +1352,72 @@ ConversionResult ConvertUTF8toUTF32 (
 /*
 **		Returns how long the UTF8 encoded string would be.
 **
+**		Each char adds one byte for being above 0x7F, and one more
+**		for being above 0x7FF (and LF adds one for CRLF). This is
+**		counted in blocks of 8 or 16 chars when SSE2 is available.
+**
 ***********************************************************************/
 {
-	REBCNT size = 0;
+	REBCNT size = len;
+	REBCNT n = 0;
 	REBCNT c;
 	REBYTE *bp = (REBYTE*)src;
 
-	for (; len > 0; len--) {
-		c = uni ? *src++ : *bp++;
-		if (c < (UTF32)0x80) {
-#ifdef TO_WIN32
-			if (ccr && c == LF) size++; // because we will add a CR to it
+#ifndef TO_WIN32
+	ccr = FALSE; // CRLF only added on Windows
 #endif
-			size++;
+
+#if defined(__SSE2__)
+	{
+		__m128i zero = _mm_setzero_si128();
+		__m128i acc, x, m1, m2, lf;
+		__m128i on = ccr ? _mm_set1_epi8(-1) : zero; // count LFs?
+		REBCNT start, end;
+
+		if (uni) {
+			m1 = _mm_set1_epi16((short)0xff80);
+			m2 = _mm_set1_epi16((short)0xf800);
+			lf = _mm_set1_epi16(LF);
+			while (n + 8 <= len) {
+				// Lanes count down by at most 2 per step, so flush in time:
+				start = n;
+				end = n + MIN((len - n) & ~7, 8 * 4096);
+				acc = zero;
+				for (; n < end; n += 8) {
+					x = _mm_loadu_si128((__m128i*)(src + n));
+					acc = _mm_add_epi16(acc, _mm_cmpeq_epi16(_mm_and_si128(x, m1), zero));
+					acc = _mm_add_epi16(acc, _mm_cmpeq_epi16(_mm_and_si128(x, m2), zero));
+					acc = _mm_sub_epi16(acc, _mm_and_si128(_mm_cmpeq_epi16(x, lf), on));
+				}
+				// Assume 2 extra bytes per char, less the ones that were not:
+				acc = _mm_madd_epi16(acc, _mm_set1_epi16(1));
+				acc = _mm_add_epi32(acc, _mm_srli_si128(acc, 8));
+				acc = _mm_add_epi32(acc, _mm_srli_si128(acc, 4));
+				size += 2 * (end - start) + _mm_cvtsi128_si32(acc);
+			}
 		}
-		else if (c < (UTF32)0x800)         size += 2;
-		else if (c < (UTF32)0x10000)       size += 3;
-		else if (c <= UNI_MAX_LEGAL_UTF32) size += 4;
-		else size += 3;
+		else {
+			lf = _mm_set1_epi8(LF);
+			while (n + 16 <= len) {
+				// Byte lanes count up by at most 1 per step:
+				end = n + MIN((len - n) & ~15, 16 * 255);
+				acc = zero;
+				for (; n < end; n += 16) {
+					x = _mm_loadu_si128((__m128i*)(bp + n));
+					acc = _mm_sub_epi8(acc, _mm_cmplt_epi8(x, zero)); // above 0x7F
+					acc = _mm_sub_epi8(acc, _mm_and_si128(_mm_cmpeq_epi8(x, lf), on));
+				}
+				acc = _mm_sad_epu8(acc, zero);
+				size += _mm_cvtsi128_si32(acc) + _mm_cvtsi128_si32(_mm_srli_si128(acc, 8));
+			}
+		}
+	}
+#endif
+
+	for (; n < len; n++) {
+		c = uni ? src[n] : bp[n];
+		size += (c >= 0x80) + (c >= 0x800);
+		if (ccr && c == LF) size++; // because we will add a CR to it
 	}
 
 	return size;
@@ -1055,28 +1487,52 @@ ConversionResult ConvertUTF8toUTF32 (
 		cnt = uni ? wcslen((REBUNI*)bp) : LEN_BYTES((REBYTE*)bp);
 	}
 
-	for (; max > 0 && cnt > 0; cnt--) {
-		c = uni ? *up++ : *bp++;
-		if (c < 0x80) {
-#if defined(TO_WIN32)
-			if (ccr && c == LF) {
-				// If there's not room, don't try to output CRLF
-				if (2 > max) {up--; break;}
-				*dst++ = CR;
-				max--;
-				c = LF;
-			}
+#if !defined(TO_WIN32)
+	ccr = FALSE; // CRLF only output on Windows
 #endif
-			*dst++ = (REBYTE)c;
-			max--;
+
+	while (max > 0 && cnt > 0) {
+		c = uni ? *up : *bp;
+		if (c < 0x80 && !(ccr && c == LF)) {
+			// Copy the whole ASCII run at once:
+			n = MIN(cnt, (REBCNT)max);
+			if (uni) {
+				n = Skip_ASCII_Uni(up, n, (REBUNI)(ccr ? LF : 0));
+				Narrow_Uni(dst, up, n);
+				up += n;
+			} else {
+				n = Skip_ASCII(bp, n, (REBYTE)(ccr ? LF : 0));
+				memcpy(dst, bp, n);
+				bp += n;
+			}
+			dst += n;
+			max -= n;
+			cnt -= n;
+			continue;
+		}
+		if (c < 0x80) {
+			// If there's not room, don't try to output CRLF
+			if (2 > max) break;
+			*dst++ = CR;
+			*dst++ = LF;
+			max -= 2;
+		}
+		else if (c < 0x800) {
+			// Latin-1 and other two byte chars:
+			if (2 > max) break;
+			*dst++ = (REBYTE)(0xC0 | (c >> 6));
+			*dst++ = (REBYTE)(0x80 | (c & 0x3F));
+			max -= 2;
 		}
 		else {
 			n = Encode_UTF8_Char(buf, c);
-			if (n > max) {up--; break;}
+			if (n > max) break;
 			memcpy(dst, buf, n);
 			dst += n;
 			max -= n;
 		}
+		if (uni) up++; else bp++;
+		cnt--;
 	}
 
 	if (len) *len = dst - bs;
@@ -1153,8 +1609,17 @@ ConversionResult ConvertUTF8toUTF32 (
 
 	} else {
 		REBUNI *up = VAL_UNI_DATA(arg);
+		REBSER *bin;
 
 		size = Length_As_UTF8(up, len, TRUE, (REBOOL)ccr);
+		if (size == len) {
+			// All ASCII, so just narrow it:
+			bin = Make_Binary(len);
+			Narrow_Uni(BIN_HEAD(bin), up, len);
+			SERIES_TAIL(bin) = len;
+			STR_TERM(bin);
+			return bin;
+		}
 		cp = Reset_Buffer(ser, size + (GET_FLAG(opts, ENC_OPT_BOM) ? 3 : 0));
 		Encode_UTF8(Reset_Buffer(ser, size), size, up, &len, TRUE, ccr);
 	}
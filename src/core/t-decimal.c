@@ -230,6 +230,10 @@ REBOOL almost_equal(REBDEC a, REBDEC b, REBCNT max_diff) {
 
 		arg = D_ARG(2);
 		type = VAL_TYPE(arg);
+
+		// Element-wise (number op vector):
+		if (type == REB_VECTOR) return T_Vector(ds, action);
+
 		if (type != REB_DECIMAL && (
 				type == REB_PAIR ||
 				type == REB_TUPLE ||
@@ -86,6 +86,7 @@
 					SET_DECIMAL(val, (REBDEC)num); // convert main arg
 					return T_Decimal(ds, action);
 				}
+				if (IS_VECTOR(val2)) return T_Vector(ds, action); // element-wise
 				if (IS_MONEY(val2)) {
 					VAL_DECI(val) = int_to_deci(VAL_INT64(val));
 					VAL_SET(val, REB_MONEY);
@@ -391,6 +391,7 @@ static REBSER *make_binary(REBVAL *arg, REBOOL make)
 		return PE_BAD_SELECT;
 
 	TRAP_PROTECT(ser);
+	if (PG_UTF8_Indexes) Free_UTF8_Index(ser);
 
 	if (BYTE_SIZE(ser) && c > 0xff) Widen_String(ser);
 	SET_ANY_CHAR(ser, n, c);
@@ -467,8 +468,11 @@ static REBSER *make_binary(REBVAL *arg, REBOOL make)
 	}
 
 	// Check must be in this order (to avoid checking a non-series value);
-	if (action >= A_TAKE && action <= A_SORT && IS_PROTECT_SERIES(VAL_SERIES(value)))
-		Trap0(RE_PROTECTED);
+	if (action >= A_TAKE && action <= A_SORT) {
+		if (IS_PROTECT_SERIES(VAL_SERIES(value))) Trap0(RE_PROTECTED);
+		// Drop the UTF-8 index of a binary that may change:
+		if (PG_UTF8_Indexes) Free_UTF8_Index(VAL_SERIES(value));
+	}
 
 	switch (action) {
 
@@ -677,6 +681,7 @@ zero_str:
 	case A_SWAP:
 		if (VAL_TYPE(value) != VAL_TYPE(arg)) Trap0(RE_NOT_SAME_TYPE);
 		if (IS_PROTECT_SERIES(VAL_SERIES(arg))) Trap0(RE_PROTECTED);
+		if (PG_UTF8_Indexes) Free_UTF8_Index(VAL_SERIES(arg));
 		if (index < tail && VAL_INDEX(arg) < VAL_TAIL(arg))
 			swap_chars(value, arg);
 		// Trap_Range(arg);  // ignore range error
@@ -709,6 +714,7 @@ zero_str:
 			index += (REBCNT)Random_Int(D_REF(3)) % (tail - index);  // /secure
 			goto pick_it;
 		}
+		if (PG_UTF8_Indexes) Free_UTF8_Index(VAL_SERIES(value));
 		Shuffle_String(value, D_REF(3));  // /secure
 		break;
 
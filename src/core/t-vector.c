@@ -29,7 +29,14 @@
 
 #include "sys-core.h"
 
-#define	SET_VECTOR(v,s) VAL_SERIES(v)=(s), VAL_INDEX(v)=0, VAL_SET(v, REB_VECTOR)
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+#ifdef __AVX__
+#include <immintrin.h>
+#endif
+
+#define	SET_VECTOR(v,s) VAL_SERIES(v)=(s), VAL_INDEX(v)=0, VAL_SERIES_SIDE(v)=0, VAL_SET(v, REB_VECTOR)
 
 // Encoding Format:
 //		stored in series->size for now
@@ -257,6 +264,22 @@ void Set_Vector_Row(REBSER *ser, REBVAL *blk)
 }
 
 
+/***********************************************************************
+**
+*/	static void Touch_Vector(REBSER *vect)
+/*
+**		Called before a vector is modified in place. A view writes
+**		into its binary, so drop the UTF-8 index of that binary.
+**
+***********************************************************************/
+{
+	REBSER *bin;
+
+	if (PG_UTF8_Indexes && IS_EXT_SERIES(vect) && NZ(bin = View_Target(vect)))
+		Free_UTF8_Index(bin);
+}
+
+
 /***********************************************************************
 **
 */	void Shuffle_Vector(REBVAL *vect, REBFLG secure)
@@ -335,62 +358,86 @@ void Set_Vector_Row(REBSER *ser, REBVAL *blk)
 
 /***********************************************************************
 **
-*/	REBVAL *Make_Vector_Spec(REBVAL *bp, REBVAL *value)
+*/	static REBFLG Get_Vector_Type(REBVAL **bpp, REBINT *type, REBINT *sign, REBINT *bits)
 /*
-**	Make a vector from a block spec.
+**		Parse the element type part of a vector spec:
 **
-**     make vector! [integer! 32 100]
-**     make vector! [decimal! 64 100]
-**     make vector! [unsigned integer! 32]
-**     Fields:
-**          signed:     signed, unsigned
-**    		datatypes:  integer, decimal
-**    		dimensions: 1 - N
-**    		bitsize:    1, 8, 16, 32, 64
-**    		size:       integer units
-**    		init:		block of values
+**			[unsigned] [integer! | decimal!] bits
+**
+**		Advances *bpp past it. Returns FALSE if not valid.
 **
 ***********************************************************************/
 {
-	REBINT type = -1; // 0 = int,    1 = float
-	REBINT sign = -1; // 0 = signed, 1 = unsigned
-	REBINT dims = 1;
-	REBINT bits = 32;
-	REBCNT size = 1;
-	REBSER *vect;
-	REBVAL *iblk = 0;
+	REBVAL *bp = *bpp;
+
+	*type = -1; // 0 = int,    1 = float
+	*sign = -1; // 0 = signed, 1 = unsigned
 
 	// UNSIGNED
 	if (IS_WORD(bp) && VAL_WORD_CANON(bp) == SYM_UNSIGNED) { 
-		sign = 1;
+		*sign = 1;
 		bp++;
 	}
 
 	// INTEGER! or DECIMAL!
 	if (IS_WORD(bp)) {
 		if (VAL_WORD_CANON(bp) == (REB_INTEGER+1)) // integer! symbol
-			type = 0;
+			*type = 0;
 		else if (VAL_WORD_CANON(bp) == (REB_DECIMAL+1)) { // decimal! symbol
-			type = 1;
-			if (sign > 0) return 0;
+			*type = 1;
+			if (*sign > 0) return FALSE;
 		}
-		else return 0;
+		else return FALSE;
 		bp++;
 	}
 
-	if (type < 0) type = 0;
-	if (sign < 0) sign = 0;
+	if (*type < 0) *type = 0;
+	if (*sign < 0) *sign = 0;
 
 	// BITS
 	if (IS_INTEGER(bp)) {
-		bits = Int32(bp);
+		*bits = Int32(bp);
 		if (
-			(bits == 32 || bits == 64)
+			(*bits == 32 || *bits == 64)
 			||
-			(type == 0 && (bits == 8 || bits == 16))
+			(*type == 0 && (*bits == 8 || *bits == 16))
 		) bp++;
-		else return 0;
-	} else return 0;
+		else return FALSE;
+	} else return FALSE;
+
+	*bpp = bp;
+	return TRUE;
+}
+
+
+/***********************************************************************
+**
+*/	REBVAL *Make_Vector_Spec(REBVAL *bp, REBVAL *value)
+/*
+**	Make a vector from a block spec.
+**
+**     make vector! [integer! 32 100]
+**     make vector! [decimal! 64 100]
+**     make vector! [unsigned integer! 32]
+**     Fields:
+**          signed:     signed, unsigned
+**    		datatypes:  integer, decimal
+**    		dimensions: 1 - N
+**    		bitsize:    1, 8, 16, 32, 64
+**    		size:       integer units
+**    		init:		block of values
+**
+***********************************************************************/
+{
+	REBINT type;
+	REBINT sign;
+	REBINT dims = 1;
+	REBINT bits = 32;
+	REBCNT size = 1;
+	REBSER *vect;
+	REBVAL *iblk = 0;
+
+	if (!Get_Vector_Type(&bp, &type, &sign, &bits)) return 0;
 
 	// SIZE
 	if (IS_INTEGER(bp)) {
@@ -424,12 +471,53 @@ void Set_Vector_Row(REBSER *ser, REBVAL *blk)
 
 	SET_TYPE(value, REB_VECTOR);
 	VAL_SERIES(value) = vect;
+	VAL_SERIES_SIDE(value) = 0;
 	// index set earlier
 
 	return value;
 }
 
 
+/***********************************************************************
+**
+*/	REBFLG Make_Vector_View(REBVAL *out, REBVAL *bin, REBVAL *spec, REBINT len)
+/*
+**		Make a vector that uses the data of a binary (from its index)
+**		without copying it. Reads and writes of the vector go straight
+**		to the binary's bytes. A negative len takes all whole elements
+**		up to the tail of the binary.
+**
+**		The view keeps the binary from being collected. The binary
+**		can still be changed: if its data is reallocated, the vector
+**		gets its own copy and is no longer a view (Detach_Views).
+**
+***********************************************************************/
+{
+	REBVAL *bp = VAL_BLK_DATA(spec);
+	REBSER *vect;
+	REBINT type;
+	REBINT sign;
+	REBINT bits = 32;
+	REBCNT wide;
+	REBCNT avail;
+
+	if (!Get_Vector_Type(&bp, &type, &sign, &bits) || NOT_END(bp)) return FALSE;
+
+	wide = bits / 8;
+	avail = VAL_LEN(bin) / wide;
+	if (len < 0) len = avail;
+	else if ((REBCNT)len > avail) Trap_Range(bin);
+
+	vect = Make_View_Series(VAL_SERIES(bin), VAL_INDEX(bin), len, wide);
+	LOCK_SERIES(vect); // (a view cannot grow)
+	vect->size = (1 << 8) | (type << 3) | (sign << 2) | (bits == 8 ? 0 : bits == 16 ? 1 : bits == 32 ? 2 : 3);
+
+	SET_VECTOR(out, vect);
+
+	return TRUE;
+}
+
+
 /***********************************************************************
 **
 */	REBFLG MT_Vector(REBVAL *out, REBVAL *data, REBCNT type)
@@ -498,6 +586,7 @@ void Set_Vector_Row(REBSER *ser, REBVAL *blk)
 
 	//--- Set Value...
 	TRAP_PROTECT(vect);
+	Touch_Vector(vect);
 
 	if (n <= 0 || (REBCNT)n > vect->tail) return PE_BAD_RANGE;
 
@@ -517,6 +606,650 @@ void Set_Vector_Row(REBSER *ser, REBVAL *blk)
 }
 
 
+/***********************************************************************
+**
+**	Vector Math
+**
+**		Element-wise math and reductions run as one typed loop per
+**		element type over the raw series data, so the compiler can
+**		keep them in registers and vectorize them. Float and double
+**		also have explicit SSE2 (and AVX) paths when compiled for it.
+**
+**		Integer add, subtract and multiply wrap around like the C
+**		types do (done unsigned, which gives the same bits). Decimal
+**		division by zero follows IEEE (no error is thrown).
+**
+**		A number is applied as given, not as the element type: a
+**		division by a number outside the type's range is done as
+**		64 bit, and a MINIMUM or MAXIMUM result outside the range
+**		is clipped to it. A number first (1 - vector) is done by
+**		the reversed ops.
+**
+***********************************************************************/
+
+enum {
+	VM_ADD = 0,
+	VM_SUBTRACT,
+	VM_MULTIPLY,
+	VM_DIVIDE,
+	VM_MINIMUM,
+	VM_MAXIMUM,
+	VM_RSUBTRACT,	// number - vector
+	VM_RDIVIDE,		// number / vector
+};
+
+#define VECT_LOOP(T, S, EXPR) \
+	if (b) for (; n < len; n++) {T x = ((T*)a)[n]; T y = ((T*)b)[n]; ((T*)dst)[n] = (EXPR);} \
+	else   for (; n < len; n++) {T x = ((T*)a)[n]; T y = (T)(S);     ((T*)dst)[n] = (EXPR);}
+
+// N / D, where each is x or y:
+#define VECT_DIV_LOOP(T, N, D) \
+	for (; n < len; n++) { \
+		T x = ((T*)a)[n]; \
+		T y = b ? ((T*)b)[n] : (T)s; \
+		if (D == 0) Trap0(RE_ZERO_DIVIDE); \
+		((T*)dst)[n] = ((T)-1 < 0 && D == (T)-1) ? (T)(0 - (REBU64)N) : N / D; \
+	}
+
+// T: element type, U: unsigned type of the same size, W: unsigned math type
+#define VECT_INT_CASE(T, U, W) \
+	switch (op) { \
+	case VM_ADD:      VECT_LOOP(U, s, (U)((W)x + (W)y)); break; \
+	case VM_SUBTRACT: VECT_LOOP(U, s, (U)((W)x - (W)y)); break; \
+	case VM_MULTIPLY: VECT_LOOP(U, s, (U)((W)x * (W)y)); break; \
+	case VM_DIVIDE:   VECT_DIV_LOOP(T, x, y); break; \
+	case VM_MINIMUM:  VECT_LOOP(T, s, (x < y) ? x : y); break; \
+	case VM_MAXIMUM:  VECT_LOOP(T, s, (x > y) ? x : y); break; \
+	case VM_RSUBTRACT: VECT_LOOP(U, s, (U)((W)y - (W)x)); break; \
+	case VM_RDIVIDE:  VECT_DIV_LOOP(T, y, x); break; \
+	} \
+	break
+
+#define VECT_DEC_CASE(T) \
+	switch (op) { \
+	case VM_ADD:      VECT_LOOP(T, f, x + y); break; \
+	case VM_SUBTRACT: VECT_LOOP(T, f, x - y); break; \
+	case VM_MULTIPLY: VECT_LOOP(T, f, x * y); break; \
+	case VM_DIVIDE:   VECT_LOOP(T, f, x / y); break; \
+	case VM_MINIMUM:  VECT_LOOP(T, f, (x < y) ? x : y); break; \
+	case VM_MAXIMUM:  VECT_LOOP(T, f, (x > y) ? x : y); break; \
+	case VM_RSUBTRACT: VECT_LOOP(T, f, y - x); break; \
+	case VM_RDIVIDE:  VECT_LOOP(T, f, y / x); break; \
+	} \
+	break
+
+#ifdef __SSE2__
+
+#define SIMD_LOOP(W, T, LOAD, STORE, FN) \
+	if (b) for (; n + W <= len; n += W) STORE((T*)dst + n, FN(LOAD((T*)a + n), LOAD((T*)b + n))); \
+	else   for (; n + W <= len; n += W) STORE((T*)dst + n, FN(LOAD((T*)a + n), vs))
+
+// Number first (there is no vector b):
+#define SIMD_RLOOP(W, T, LOAD, STORE, FN) \
+	if (!b) for (; n + W <= len; n += W) STORE((T*)dst + n, FN(vs, LOAD((T*)a + n)))
+
+#define SIMD_CASE(W, T, LOAD, STORE, ADD, SUB, MUL, DIV, MN, MX) \
+	switch (op) { \
+	case VM_ADD:      SIMD_LOOP(W, T, LOAD, STORE, ADD); break; \
+	case VM_SUBTRACT: SIMD_LOOP(W, T, LOAD, STORE, SUB); break; \
+	case VM_MULTIPLY: SIMD_LOOP(W, T, LOAD, STORE, MUL); break; \
+	case VM_DIVIDE:   SIMD_LOOP(W, T, LOAD, STORE, DIV); break; \
+	case VM_MINIMUM:  SIMD_LOOP(W, T, LOAD, STORE, MN); break; \
+	case VM_MAXIMUM:  SIMD_LOOP(W, T, LOAD, STORE, MX); break; \
+	case VM_RSUBTRACT: SIMD_RLOOP(W, T, LOAD, STORE, SUB); break; \
+	case VM_RDIVIDE:  SIMD_RLOOP(W, T, LOAD, STORE, DIV); break; \
+	}
+
+/***********************************************************************
+**
+*/	static REBCNT Simd_Math_F32(REBCNT op, REBYTE *dst, REBYTE *a, REBYTE *b, REBDEC f, REBCNT len)
+/*
+**		Returns the number of elements done. The caller does the rest.
+**
+***********************************************************************/
+{
+	REBCNT n = 0;
+#ifdef __AVX__
+	{
+		__m256 vs = _mm256_set1_ps((float)f);
+		SIMD_CASE(8, float, _mm256_loadu_ps, _mm256_storeu_ps,
+			_mm256_add_ps, _mm256_sub_ps, _mm256_mul_ps, _mm256_div_ps, _mm256_min_ps, _mm256_max_ps);
+	}
+#endif
+	{
+		__m128 vs = _mm_set1_ps((float)f);
+		SIMD_CASE(4, float, _mm_loadu_ps, _mm_storeu_ps,
+			_mm_add_ps, _mm_sub_ps, _mm_mul_ps, _mm_div_ps, _mm_min_ps, _mm_max_ps);
+	}
+	return n;
+}
+
+/***********************************************************************
+**
+*/	static REBCNT Simd_Math_F64(REBCNT op, REBYTE *dst, REBYTE *a, REBYTE *b, REBDEC f, REBCNT len)
+/*
+**		Returns the number of elements done. The caller does the rest.
+**
+***********************************************************************/
+{
+	REBCNT n = 0;
+#ifdef __AVX__
+	{
+		__m256d vs = _mm256_set1_pd(f);
+		SIMD_CASE(4, double, _mm256_loadu_pd, _mm256_storeu_pd,
+			_mm256_add_pd, _mm256_sub_pd, _mm256_mul_pd, _mm256_div_pd, _mm256_min_pd, _mm256_max_pd);
+	}
+#endif
+	{
+		__m128d vs = _mm_set1_pd(f);
+		SIMD_CASE(2, double, _mm_loadu_pd, _mm_storeu_pd,
+			_mm_add_pd, _mm_sub_pd, _mm_mul_pd, _mm_div_pd, _mm_min_pd, _mm_max_pd);
+	}
+	return n;
+}
+
+#endif // __SSE2__
+
+
+/***********************************************************************
+**
+*/	static void Vect_Math(REBCNT op, REBCNT type, REBYTE *dst, REBYTE *a, REBYTE *b, REBI64 s, REBDEC f, REBCNT len)
+/*
+**		Element-wise dst = a op b, or dst = a op scalar when b is zero.
+**		All three have the same element type. The scalar is given as
+**		an integer (s) for integer types and as a decimal (f) for
+**		decimal types.
+**
+***********************************************************************/
+{
+	REBCNT n = 0;
+
+	switch (type) {
+	case VTSI08: VECT_INT_CASE(signed char, u8, REBCNT);
+	case VTUI08: VECT_INT_CASE(u8, u8, REBCNT);
+	case VTSI16: VECT_INT_CASE(i16, u16, REBCNT);
+	case VTUI16: VECT_INT_CASE(u16, u16, REBCNT);
+	case VTSI32: VECT_INT_CASE(REBINT, REBCNT, REBCNT);
+	case VTUI32: VECT_INT_CASE(REBCNT, REBCNT, REBCNT);
+	case VTSI64: VECT_INT_CASE(i64, u64, u64);
+	case VTUI64: VECT_INT_CASE(u64, u64, u64);
+
+	case VTSF32:
+#ifdef __SSE2__
+		n = Simd_Math_F32(op, dst, a, b, f, len);
+#endif
+		VECT_DEC_CASE(float);
+
+	case VTSF64:
+#ifdef __SSE2__
+		n = Simd_Math_F64(op, dst, a, b, f, len);
+#endif
+		VECT_DEC_CASE(double);
+	}
+}
+
+
+/***********************************************************************
+**
+*/	static REBDEC get_vect_dec(REBCNT type, REBYTE *data, REBCNT n)
+/*
+***********************************************************************/
+{
+	union {REBU64 i; REBDEC d;} v;
+
+	v.i = get_vect(type, data, n);
+	if (type >= VTSF08) return v.d;
+	if (type == VTUI64) return (REBDEC)v.i;
+	return (REBDEC)(REBI64)v.i;
+}
+
+
+/***********************************************************************
+**
+*/	static void Vect_Math_Mixed(REBCNT op, REBCNT type, REBYTE *dst, REBYTE *a, REBCNT btype, REBYTE *b, REBI64 s, REBDEC f, REBFLG ints, REBCNT len)
+/*
+**		Slow path for element types that differ, or a number that is
+**		not of the element type. The number is s when ints is set,
+**		else f. Integers combine as 64 bit, anything else as decimal,
+**		and the result is stored as the type of a.
+**
+***********************************************************************/
+{
+	REBCNT n;
+	REBI64 x, y;
+	REBDEC fx, fy;
+
+	if (type < VTSF08 && (b ? btype < VTSF08 : ints)) {
+		for (n = 0; n < len; n++) {
+			x = (REBI64)get_vect(type, a, n);
+			y = b ? (REBI64)get_vect(btype, b, n) : s;
+			if (op == VM_RSUBTRACT || op == VM_RDIVIDE) {
+				REBI64 t = x;
+				x = y;
+				y = t;
+			}
+			switch (op) {
+			case VM_ADD:      x = (REBI64)((REBU64)x + (REBU64)y); break;
+			case VM_SUBTRACT:
+			case VM_RSUBTRACT: x = (REBI64)((REBU64)x - (REBU64)y); break;
+			case VM_MULTIPLY: x = (REBI64)((REBU64)x * (REBU64)y); break;
+			case VM_DIVIDE:
+			case VM_RDIVIDE:
+				if (y == 0) Trap0(RE_ZERO_DIVIDE);
+				x = (y == -1) ? (REBI64)(0 - (REBU64)x) : x / y;
+				break;
+			case VM_MINIMUM:  if (y < x) x = y; break;
+			case VM_MAXIMUM:  if (y > x) x = y; break;
+			}
+			set_vect(type, dst, n, x, 0);
+		}
+		return;
+	}
+
+	for (n = 0; n < len; n++) {
+		fx = get_vect_dec(type, a, n);
+		fy = b ? get_vect_dec(btype, b, n) : (ints ? (REBDEC)s : f);
+		if (op == VM_RSUBTRACT || op == VM_RDIVIDE) {
+			REBDEC t = fx;
+			fx = fy;
+			fy = t;
+		}
+		switch (op) {
+		case VM_ADD:      fx += fy; break;
+		case VM_SUBTRACT:
+		case VM_RSUBTRACT: fx -= fy; break;
+		case VM_MULTIPLY: fx *= fy; break;
+		case VM_DIVIDE:
+		case VM_RDIVIDE:
+			if (fy == 0.0 && type < VTSF08) Trap0(RE_ZERO_DIVIDE);
+			fx /= fy;
+			break;
+		case VM_MINIMUM:  if (fy < fx) fx = fy; break;
+		case VM_MAXIMUM:  if (fy > fx) fx = fy; break;
+		}
+		set_vect(type, dst, n, (REBI64)fx, fx);
+	}
+}
+
+
+/***********************************************************************
+**
+*/	static void Vect_Int_Range(REBCNT type, REBI64 *lo, REBI64 *hi)
+/*
+**		Range of the values of an integer element type (as 64 bit).
+**
+***********************************************************************/
+{
+	REBCNT bits = bit_sizes[type & 3];
+
+	if (type < VTUI08) {
+		*hi = (bits == 64) ? MAX_I64 : ((REBI64)1 << (bits - 1)) - 1;
+		*lo = -*hi - 1;
+	}
+	else {
+		*hi = (bits == 64) ? MAX_I64 : ((REBI64)1 << bits) - 1;
+		*lo = 0;
+	}
+}
+
+
+/***********************************************************************
+**
+*/	static void Do_Vector_Math(REBVAL *value, REBVAL *arg, REBCNT op)
+/*
+**		Vector op vector (of the same length), vector op number, or
+**		number op vector. The result is a new vector of the type of
+**		the vector (the first one), which is returned in value.
+**
+***********************************************************************/
+{
+	REBSER *vect;
+	REBCNT type;
+	REBCNT len;
+	REBSER *ser;
+	REBI64 i = 0;
+	REBDEC f = 0;
+	REBI64 lo, hi;
+	REBVAL tmp;
+
+	// Number first (from the number's action, or MINIMUM):
+	if (!IS_VECTOR(value)) {
+		tmp = *value;
+		*value = *arg;
+		*arg = tmp;
+		if (op == VM_SUBTRACT) op = VM_RSUBTRACT;
+		else if (op == VM_DIVIDE) op = VM_RDIVIDE;
+	}
+
+	vect = VAL_SERIES(value);
+	type = VECT_TYPE(vect);
+	len = VAL_LEN(value);
+
+	if (IS_VECTOR(arg)) {
+		if (VAL_LEN(arg) != len) Trap_Arg(arg);
+	}
+	else if (IS_INTEGER(arg)) {
+		i = VAL_INT64(arg);
+		f = (REBDEC)i;
+	}
+	else if (IS_DECIMAL(arg) || IS_PERCENT(arg)) {
+		f = VAL_DECIMAL(arg);
+	}
+	else Trap_Arg(arg);
+
+	ser = Make_Series(len + 1, SERIES_WIDE(vect), FALSE);
+	LABEL_SERIES(ser, "vector math");
+	ser->tail = len;
+	ser->size = vect->size; // attributes
+
+	if (IS_VECTOR(arg)) {
+		if (VECT_TYPE(VAL_SERIES(arg)) == type)
+			Vect_Math(op, type, ser->data, VAL_DATA(value), VAL_DATA(arg), 0, 0, len);
+		else
+			Vect_Math_Mixed(op, type, ser->data, VAL_DATA(value), VECT_TYPE(VAL_SERIES(arg)), VAL_DATA(arg), 0, 0, FALSE, len);
+		goto done;
+	}
+
+	if (type < VTSF08 && !IS_INTEGER(arg)) {
+		Vect_Math_Mixed(op, type, ser->data, VAL_DATA(value), 0, 0, 0, f, FALSE, len);
+		goto done;
+	}
+
+	// An integer outside the element range. Add, subtract and
+	// multiply wrap to the same bits, so only these differ:
+	if (type < VTSF08) {
+		Vect_Int_Range(type, &lo, &hi);
+		if (i < lo || i > hi) {
+			if (op == VM_MINIMUM || op == VM_MAXIMUM) i = (i < lo) ? lo : hi;
+			else if (op == VM_DIVIDE || op == VM_RDIVIDE) {
+				Vect_Math_Mixed(op, type, ser->data, VAL_DATA(value), 0, 0, i, 0, TRUE, len);
+				goto done;
+			}
+		}
+	}
+	Vect_Math(op, type, ser->data, VAL_DATA(value), 0, i, f, len);
+
+done:
+
+	SET_VECTOR(value, ser);
+}
+
+
+/***********************************************************************
+**
+*/	REBINT Min_Max_Vector(REBVAL *ds, REBFLG maxed)
+/*
+**		Element-wise MINIMUM and MAXIMUM of a vector with a vector
+**		or a number.
+**
+***********************************************************************/
+{
+	REBVAL *a = D_ARG(1);
+	REBVAL *b = D_ARG(2);
+
+	if (!IS_VECTOR(a)) {
+		// Number first, vector second:
+		a = D_ARG(2);
+		b = D_ARG(1);
+	}
+
+	*D_RET = *a;
+	Do_Vector_Math(D_RET, b, maxed ? VM_MAXIMUM : VM_MINIMUM);
+	return R_RET;
+}
+
+
+/***********************************************************************
+**
+*/	void Sum_Vector(REBVAL *vect, REBVAL *out)
+/*
+**		Sum of all elements from the vector's index. Integers sum
+**		as 64 bit (wrapping), float and double sum as double.
+**
+***********************************************************************/
+{
+	REBCNT type = VECT_TYPE(VAL_SERIES(vect));
+	REBCNT len = VAL_LEN(vect);
+	REBYTE *data = VAL_DATA(vect);
+	REBCNT n = 0;
+	REBU64 acc = 0;
+	REBDEC sum = 0;
+
+#define VECT_SUM(T, A) {T *p = (T*)data; for (; n < len; n++) A += p[n];} break
+
+	switch (type) {
+	case VTSI08: VECT_SUM(signed char, acc);
+	case VTUI08: VECT_SUM(u8, acc);
+	case VTSI16: VECT_SUM(i16, acc);
+	case VTUI16: VECT_SUM(u16, acc);
+	case VTSI32: VECT_SUM(REBINT, acc);
+	case VTUI32: VECT_SUM(REBCNT, acc);
+	case VTSI64: VECT_SUM(i64, acc);
+	case VTUI64: VECT_SUM(u64, acc);
+
+	case VTSF32:
+#ifdef __SSE2__
+		{
+			__m128d lo = _mm_setzero_pd();
+			__m128d hi = _mm_setzero_pd();
+			__m128 x;
+			double t[2];
+			for (; n + 4 <= len; n += 4) {
+				x = _mm_loadu_ps((float*)data + n);
+				lo = _mm_add_pd(lo, _mm_cvtps_pd(x));
+				hi = _mm_add_pd(hi, _mm_cvtps_pd(_mm_movehl_ps(x, x)));
+			}
+			_mm_storeu_pd(t, _mm_add_pd(lo, hi));
+			sum = t[0] + t[1];
+		}
+#endif
+		VECT_SUM(float, sum);
+
+	case VTSF64:
+#ifdef __SSE2__
+		{
+			__m128d s1 = _mm_setzero_pd();
+			__m128d s2 = _mm_setzero_pd();
+			double t[2];
+			for (; n + 4 <= len; n += 4) {
+				s1 = _mm_add_pd(s1, _mm_loadu_pd((double*)data + n));
+				s2 = _mm_add_pd(s2, _mm_loadu_pd((double*)data + n + 2));
+			}
+			_mm_storeu_pd(t, _mm_add_pd(s1, s2));
+			sum = t[0] + t[1];
+		}
+#endif
+		VECT_SUM(double, sum);
+	}
+
+	if (type < VTSF08) {
+		SET_INTEGER(out, (REBI64)acc);
+	}
+	else {
+		SET_DECIMAL(out, sum);
+	}
+}
+
+
+/***********************************************************************
+**
+*/	void Limit_Vector(REBVAL *vect, REBFLG maxed, REBVAL *out)
+/*
+**		Smallest (or largest) element from the vector's index.
+**		Returns NONE for an empty vector.
+**
+***********************************************************************/
+{
+	REBCNT type = VECT_TYPE(VAL_SERIES(vect));
+	REBCNT len = VAL_LEN(vect);
+	REBYTE *data = VAL_DATA(vect);
+	REBCNT n = 1;
+	REBI64 i = 0;
+	REBDEC f = 0;
+
+	if (len == 0) {
+		SET_NONE(out);
+		return;
+	}
+
+#define VECT_LIMIT(T, R) { \
+		T *p = (T*)data; \
+		T m = p[0]; \
+		if (maxed) {for (; n < len; n++) m = (p[n] > m) ? p[n] : m;} \
+		else       {for (; n < len; n++) m = (p[n] < m) ? p[n] : m;} \
+		R = m; \
+	} break
+
+	switch (type) {
+	case VTSI08: VECT_LIMIT(signed char, i);
+	case VTUI08: VECT_LIMIT(u8, i);
+	case VTSI16: VECT_LIMIT(i16, i);
+	case VTUI16: VECT_LIMIT(u16, i);
+	case VTSI32: VECT_LIMIT(REBINT, i);
+	case VTUI32: VECT_LIMIT(REBCNT, i);
+	case VTSI64: VECT_LIMIT(i64, i);
+	case VTUI64: VECT_LIMIT(u64, i);
+
+	case VTSF32:
+		f = ((float*)data)[0];
+#ifdef __SSE2__
+		if (len >= 4) {
+			__m128 m = _mm_loadu_ps((float*)data);
+			float t[4];
+			REBCNT k;
+			for (n = 4; n + 4 <= len; n += 4) {
+				__m128 x = _mm_loadu_ps((float*)data + n);
+				m = maxed ? _mm_max_ps(m, x) : _mm_min_ps(m, x);
+			}
+			_mm_storeu_ps(t, m);
+			for (k = 0; k < 4; k++) {
+				if (maxed ? (t[k] > f) : (t[k] < f)) f = t[k];
+			}
+		}
+#endif
+		for (; n < len; n++) {
+			REBDEC x = ((float*)data)[n];
+			if (maxed ? (x > f) : (x < f)) f = x;
+		}
+		break;
+
+	case VTSF64:
+		f = ((double*)data)[0];
+#ifdef __SSE2__
+		if (len >= 2) {
+			__m128d m = _mm_loadu_pd((double*)data);
+			double t[2];
+			REBCNT k;
+			for (n = 2; n + 2 <= len; n += 2) {
+				__m128d x = _mm_loadu_pd((double*)data + n);
+				m = maxed ? _mm_max_pd(m, x) : _mm_min_pd(m, x);
+			}
+			_mm_storeu_pd(t, m);
+			for (k = 0; k < 2; k++) {
+				if (maxed ? (t[k] > f) : (t[k] < f)) f = t[k];
+			}
+		}
+#endif
+		for (; n < len; n++) {
+			REBDEC x = ((double*)data)[n];
+			if (maxed ? (x > f) : (x < f)) f = x;
+		}
+		break;
+	}
+
+	if (type < VTSF08) {
+		SET_INTEGER(out, i);
+	}
+	else {
+		SET_DECIMAL(out, f);
+	}
+}
+
+
+/***********************************************************************
+**
+*/	void Dot_Vector(REBVAL *v1, REBVAL *v2, REBVAL *out)
+/*
+**		Dot product of two vectors of the same length. Integer
+**		vectors of the same type give an integer (64 bit, wrapping),
+**		anything else gives a decimal.
+**
+***********************************************************************/
+{
+	REBCNT type = VECT_TYPE(VAL_SERIES(v1));
+	REBCNT type2 = VECT_TYPE(VAL_SERIES(v2));
+	REBCNT len = VAL_LEN(v1);
+	REBYTE *a = VAL_DATA(v1);
+	REBYTE *b = VAL_DATA(v2);
+	REBCNT n = 0;
+	REBU64 acc = 0;
+	REBDEC sum = 0;
+
+	if (VAL_LEN(v2) != len) Trap_Arg(v2);
+
+	if (type != type2) {
+		for (; n < len; n++) sum += get_vect_dec(type, a, n) * get_vect_dec(type2, b, n);
+		SET_DECIMAL(out, sum);
+		return;
+	}
+
+#define VECT_DOT(T, W, A) {T *p = (T*)a; T *q = (T*)b; for (; n < len; n++) A += (W)p[n] * (W)q[n];} break
+
+	switch (type) {
+	case VTSI08: VECT_DOT(signed char, REBU64, acc);
+	case VTUI08: VECT_DOT(u8, REBU64, acc);
+	case VTSI16: VECT_DOT(i16, REBU64, acc);
+	case VTUI16: VECT_DOT(u16, REBU64, acc);
+	case VTSI32: VECT_DOT(REBINT, REBU64, acc);
+	case VTUI32: VECT_DOT(REBCNT, REBU64, acc);
+	case VTSI64: VECT_DOT(i64, REBU64, acc);
+	case VTUI64: VECT_DOT(u64, REBU64, acc);
+
+	case VTSF32:
+#ifdef __SSE2__
+		{
+			__m128d lo = _mm_setzero_pd();
+			__m128d hi = _mm_setzero_pd();
+			__m128 x, y;
+			double t[2];
+			for (; n + 4 <= len; n += 4) {
+				x = _mm_loadu_ps((float*)a + n);
+				y = _mm_loadu_ps((float*)b + n);
+				lo = _mm_add_pd(lo, _mm_mul_pd(_mm_cvtps_pd(x), _mm_cvtps_pd(y)));
+				hi = _mm_add_pd(hi, _mm_mul_pd(_mm_cvtps_pd(_mm_movehl_ps(x, x)), _mm_cvtps_pd(_mm_movehl_ps(y, y))));
+			}
+			_mm_storeu_pd(t, _mm_add_pd(lo, hi));
+			sum = t[0] + t[1];
+		}
+#endif
+		VECT_DOT(float, REBDEC, sum);
+
+	case VTSF64:
+#ifdef __SSE2__
+		{
+			__m128d s1 = _mm_setzero_pd();
+			__m128d s2 = _mm_setzero_pd();
+			double t[2];
+			for (; n + 4 <= len; n += 4) {
+				s1 = _mm_add_pd(s1, _mm_mul_pd(_mm_loadu_pd((double*)a + n), _mm_loadu_pd((double*)b + n)));
+				s2 = _mm_add_pd(s2, _mm_mul_pd(_mm_loadu_pd((double*)a + n + 2), _mm_loadu_pd((double*)b + n + 2)));
+			}
+			_mm_storeu_pd(t, _mm_add_pd(s1, s2));
+			sum = t[0] + t[1];
+		}
+#endif
+		VECT_DOT(double, REBDEC, sum);
+	}
+
+	if (type < VTSF08) {
+		SET_INTEGER(out, (REBI64)acc);
+	}
+	else {
+		SET_DECIMAL(out, sum);
+	}
+}
+
+
 /***********************************************************************
 **
 */	REBTYPE(Vector)
@@ -530,14 +1263,33 @@ void Set_Vector_Row(REBSER *ser, REBVAL *blk)
 	REBSER *vect;
 	REBSER *ser;
 
+	// Element-wise math (the series actions would refuse it).
+	// The value is a number when called by the number's action:
+	switch (action) {
+	case A_ADD:
+		Do_Vector_Math(value, arg, VM_ADD);
+		return R_ARG1;
+	case A_SUBTRACT:
+		Do_Vector_Math(value, arg, VM_SUBTRACT);
+		return R_ARG1;
+	case A_MULTIPLY:
+		Do_Vector_Math(value, arg, VM_MULTIPLY);
+		return R_ARG1;
+	case A_DIVIDE:
+		Do_Vector_Math(value, arg, VM_DIVIDE);
+		return R_ARG1;
+	}
+
 	type = Do_Series_Action(action, value, arg);
 	if (type >= 0) return type;
 
 	vect = VAL_SERIES(value); // not valid for MAKE or TO
 
 	// Check must be in this order (to avoid checking a non-series value);
-	if (action >= A_TAKE && action <= A_SORT && IS_PROTECT_SERIES(vect))
-		Trap0(RE_PROTECTED);
+	if (action >= A_TAKE && action <= A_SORT) {
+		if (IS_PROTECT_SERIES(vect)) Trap0(RE_PROTECTED);
+		Touch_Vector(vect);
+	}
 
 	switch (action) {
 
@@ -579,13 +1331,19 @@ void Set_Vector_Row(REBSER *ser, REBVAL *blk)
 		return R_RET;
 
 	case A_COPY:
-		ser = Copy_Series(vect);
+		// (Not Copy_Series, a view has no terminator to copy.)
+		size = SERIES_WIDE(vect);
+		ser = Make_Series(vect->tail + 1, size, FALSE);
+		memcpy(ser->data, vect->data, vect->tail * size);
+		CLEAR(ser->data + vect->tail * size, size);
+		ser->tail = vect->tail;
 		ser->size = vect->size; // attributes
 		SET_VECTOR(value, ser);
 		break;
 
 	case A_RANDOM:
 		if (D_REF(2) || D_REF(4)) Trap0(RE_BAD_REFINES); // /seed /only
+		Touch_Vector(vect);
 		Shuffle_Vector(value, D_REF(3));
 		return R_ARG1;
 
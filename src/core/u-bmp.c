@@ -278,11 +278,17 @@ void Unmap_Bytes(void *srcp, REBYTE **dstp, char *map) {
 **		Error:  Code in codi->error
 **		Return: Success as TRUE or FALSE
 **
+**		For CODI_DECODE_ROWS, uncompressed bitmaps are read a row
+**		at a time from the bottom-up file rows; RLE ones are decoded
+**		in full.
+**
 ***********************************************************************/
 {
 	REBINT				i, j, x, y, c;
 	REBINT				colors, compression, bitcount;
 	REBINT				w, h;
+	REBINT				stride = 0;
+	REBYTE				*base;
 	BITMAPFILEHEADER	bmfh;
 	BITMAPINFOHEADER	bmih;
 	BITMAPCOREHEADER	bmch;
@@ -348,12 +354,23 @@ void Unmap_Bytes(void *srcp, REBYTE **dstp, char *map) {
 
 	codi->w = w;
 	codi->h = h;
-	codi->bits = Make_Mem(w * h * 4);
 
-	dp = (REBCNT *) codi->bits;
-	dp += w * h - w;
+	if (codi->action == CODI_DECODE_ROWS && compression == BI_RGB) {
+		stride = ((w * bitcount + 31) / 32) * 4;
+		base = cp;
+		codi->bits = Make_Mem(w * 4);
+	}
+	else {
+		codi->bits = Make_Mem(w * h * 4);
+		dp = (REBCNT *) codi->bits;
+		dp += w * h - w;
+	}
 
 	for (y = 0; y<h; y++) {
+		if (stride) {
+			cp = base + (h - 1 - y) * stride;
+			dp = (REBCNT *) codi->bits;
+		}
 		switch(compression) {
 		case BI_RGB:
 			switch(bitcount) {
@@ -497,9 +514,16 @@ void Unmap_Bytes(void *srcp, REBYTE **dstp, char *map) {
 			codi->error = CODI_ERR_ENCODING;
 			goto error;
 		}
-		dp -= 2 * w;
+		if (stride) {
+			if (codi->rows(codi, y, 1, codi->bits)) break;
+		}
+		else dp -= 2 * w;
 	}
 error:
+	if (stride) {
+		Free_Mem(codi->bits, w * 4);
+		codi->bits = 0;
+	}
 	if (ctab) free(ctab);
 }
 
@@ -582,7 +606,7 @@ error:
 		return CODI_CHECK; // error code is inverted result
 	}
 
-	if (codi->action == CODI_DECODE) {
+	if (codi->action == CODI_DECODE || codi->action == CODI_DECODE_ROWS) {
 		Decode_BMP_Image(codi);
 		return CODI_IMAGE;
 	}
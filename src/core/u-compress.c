@@ -54,15 +54,186 @@
 */
 #define WHY_COMPRESS_CONSTANT       0.1
 
+/*
+ *  Parallel compression cuts the input into blocks of this size. Each
+ *  block is deflated on its own, primed with the PRESS_DICT bytes before
+ *  it, into a slot of PRESS_SLOT bytes (room for incompressible data).
+ */
+#define PRESS_BLOCK         (128 * 1024)
+#define PRESS_SLOT          (PRESS_BLOCK + PRESS_BLOCK / 16)
+#define PRESS_DICT          32768
+#define MAX_PRESS_THREADS   64
+
+#define OCID_CPU_COUNT      2   // OS_Config id (see host-lib.c)
+
+typedef struct rebol_press_blocks {
+	REBYTE *data;       // input
+	REBCNT len;         // input length
+	REBCNT count;       // number of blocks
+	REBCNT step;        // number of deflate threads
+	REBYTE *out;        // output slots
+	REBCNT *size;       // deflated size of each block
+	REBFLG use_crc;
+	REBCNT check;       // ADLER32 (or CRC32) of the input
+} REBPRS;
+
+typedef struct rebol_press_thread {
+	REBPRS *press;
+	REBCNT first;       // first block (count for the checksum thread)
+	REBINT err;
+} REBPRT;
+
+
+/***********************************************************************
+**
+*/  static void Trap_Press(REBINT err)
+/*
+***********************************************************************/
+{
+	if (err == Z_MEM_ERROR) Trap0(RE_NO_MEMORY);
+	SET_INTEGER(DS_RETURN, err);
+	Trap1(RE_BAD_PRESS, DS_RETURN); //!!!provide error string descriptions
+}
+
+
 /***********************************************************************
 **
-*/  REBSER *Compress(REBSER *input, REBINT index, REBINT len, REBFLG use_crc)
+*/  static void Press_Thread(void *arg)
+/*
+**      Deflate every step'th block, starting at the first. Each is a
+**      raw deflate of its own that ends on a byte boundary (with a
+**      sync flush) so the blocks can simply be joined. The extra
+**      thread computes the checksum of the whole input instead.
+**
+**      Runs outside of the interpreter: no traps, no series.
+**
+***********************************************************************/
+{
+	REBPRT *thr = (REBPRT *)arg;
+	REBPRS *prs = thr->press;
+	z_stream strm;
+	REBCNT n;
+	REBCNT start;
+	REBCNT dict;
+	REBINT last;
+	REBINT err;
+
+	if (thr->first == prs->count) {
+		if (prs->use_crc) prs->check = Update_CRC32(0, prs->data, prs->len);
+		else prs->check = Update_ADLER32(1, prs->data, prs->len);
+		return;
+	}
+
+	for (n = thr->first; n < prs->count; n += prs->step) {
+		start = n * PRESS_BLOCK;
+		dict = MIN(start, PRESS_DICT);
+		last = (n == prs->count - 1);
+
+		CLEARS(&strm);
+		strm.checksum = adler32;
+		err = deflateInit2(&strm, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -MAX_WBITS, DEF_MEM_LEVEL, Z_DEFAULT_STRATEGY);
+		if (err == Z_OK && dict) err = deflateSetDictionary(&strm, prs->data + start - dict, dict);
+		if (err == Z_OK) {
+			strm.next_in = prs->data + start;
+			strm.avail_in = MIN(prs->len - start, PRESS_BLOCK);
+			strm.next_out = prs->out + n * PRESS_SLOT;
+			strm.avail_out = PRESS_SLOT;
+			err = deflate(&strm, last ? Z_FINISH : Z_SYNC_FLUSH);
+			// All of it must fit in the slot:
+			if (err == (last ? Z_STREAM_END : Z_OK) && !strm.avail_in && strm.avail_out) err = Z_OK;
+			else if (err == Z_OK || err == Z_STREAM_END) err = Z_BUF_ERROR;
+			prs->size[n] = PRESS_SLOT - strm.avail_out;
+			deflateEnd(&strm);
+		}
+		if (err != Z_OK) {
+			thr->err = err;
+			return;
+		}
+	}
+}
+
+
+/***********************************************************************
+**
+*/  static REBSER *Compress_Blocks(REBYTE *data, REBCNT len, REBFLG use_crc, REBCNT threads)
+/*
+**      Compress large data on several threads, as pigz does. The
+**      input is cut into blocks that are deflated at the same time,
+**      then joined into a single zlib stream that DECOMPRESS takes
+**      as usual. The result does not depend on the thread count.
+**
+***********************************************************************/
+{
+	REBPRS prs;
+	REBPRT thr[MAX_PRESS_THREADS + 1];
+	void *args[MAX_PRESS_THREADS + 1];
+	REBSER *output;
+	REBYTE *bp;
+	REBCNT n;
+	REBINT err = Z_OK;
+
+	prs.data = data;
+	prs.len = len;
+	prs.count = (len + PRESS_BLOCK - 1) / PRESS_BLOCK;
+	prs.step = MIN(threads, prs.count);
+	prs.use_crc = use_crc;
+	prs.check = 0;
+
+	// Header, one slot per block, then the check value and size tag:
+	output = Make_Binary(2 + prs.count * PRESS_SLOT + 8);
+	prs.out = BIN_SKIP(output, 2);
+	prs.size = Make_Mem(prs.count * sizeof(REBCNT));
+	if (!prs.size) Trap0(RE_NO_MEMORY);
+
+	for (n = 0; n <= prs.step; n++) {
+		thr[n].press = &prs;
+		thr[n].first = (n < prs.step) ? n : prs.count;
+		thr[n].err = Z_OK;
+		args[n] = &thr[n];
+	}
+	OS_RUN_THREADS(Press_Thread, args, prs.step + 1);
+
+	for (n = 0; n <= prs.step; n++) {
+		if (thr[n].err != Z_OK) err = thr[n].err;
+	}
+	if (err != Z_OK) {
+		Free_Mem(prs.size, prs.count * sizeof(REBCNT));
+		Trap_Press(err);
+	}
+
+	// Zlib header: deflate with a 32K window, default level:
+	bp = BIN_HEAD(output);
+	*bp++ = 0x78;
+	*bp++ = 0x9c;
+
+	// Close up the slots (the first is already in place):
+	bp += prs.size[0];
+	for (n = 1; n < prs.count; n++) {
+		memmove(bp, prs.out + n * PRESS_SLOT, prs.size[n]);
+		bp += prs.size[n];
+	}
+	Free_Mem(prs.size, prs.count * sizeof(REBCNT));
+
+	*bp++ = (REBYTE)(prs.check >> 24);
+	*bp++ = (REBYTE)(prs.check >> 16);
+	*bp++ = (REBYTE)(prs.check >> 8);
+	*bp++ = (REBYTE)prs.check;
+
+	SERIES_TAIL(output) = bp - BIN_HEAD(output);
+	return output;
+}
+
+
+/***********************************************************************
+**
+*/  REBSER *Compress(REBSER *input, REBINT index, REBINT len, REBFLG use_crc, REBCNT threads)
 /*
 **      Compress a binary (only).
 **		data
 **		/part
 **		length
 **		/crc32
+**		threads (zero for one per CPU)
 **
 **      Note: If the file length is "small", it can't overrun on
 **      compression too much so we use our magic numbers; otherwise,
@@ -77,16 +248,22 @@
 	REBYTE out_size[4];
 
 	if (len < 0) Trap0(RE_PAST_END); // !!! better msg needed
-	size = len + (len > STERLINGS_MAGIC_NUMBER ? len / 10 + 12 : STERLINGS_MAGIC_FIX);
-	output = Make_Binary(size);
 
-	//DISABLE_GC;	// !!! why??
-	// dest, dest-len, src, src-len, level
-	err = Z_compress2(BIN_HEAD(output), (uLongf*)&size, BIN_HEAD(input) + index, len, use_crc);
-	if (err) {
-		if (err == Z_MEM_ERROR) Trap0(RE_NO_MEMORY);
-		SET_INTEGER(DS_RETURN, err);
-		Trap1(RE_BAD_PRESS, DS_RETURN); //!!!provide error string descriptions
+	if (threads == 0) threads = MAX(1, OS_CONFIG(OCID_CPU_COUNT, 0));
+	if (threads > MAX_PRESS_THREADS) threads = MAX_PRESS_THREADS;
+
+	if (threads > 1 && len > PRESS_BLOCK) {
+		output = Compress_Blocks(BIN_HEAD(input) + index, len, use_crc, threads);
+		size = SERIES_TAIL(output);
+	}
+	else {
+		size = len + (len > STERLINGS_MAGIC_NUMBER ? len / 10 + 12 : STERLINGS_MAGIC_FIX);
+		output = Make_Binary(size);
+
+		//DISABLE_GC;	// !!! why??
+		// dest, dest-len, src, src-len, level
+		err = Z_compress2(BIN_HEAD(output), (uLongf*)&size, BIN_HEAD(input) + index, len, use_crc);
+		if (err) Trap_Press(err);
 	}
 	SET_STR_END(output, size);
 	SERIES_TAIL(output) = size;
@@ -126,9 +303,7 @@
 	err = Z_uncompress(BIN_HEAD(output), (uLongf*)&size, BIN_HEAD(input) + index, len, use_crc);
 	if (err) {
 		if (PG_Boot_Phase < 2) return 0;
-		if (err == Z_MEM_ERROR) Trap0(RE_NO_MEMORY);
-		SET_INTEGER(DS_RETURN, err);
-		Trap1(RE_BAD_PRESS, DS_RETURN); //!!!provide error string descriptions
+		Trap_Press(err);
 	}
 	SET_STR_END(output, size);
 	SERIES_TAIL(output) = size;
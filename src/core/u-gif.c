@@ -73,10 +73,13 @@ void Chrom_Key_Alpha(REBVAL *v,REBCNT col,REBINT blitmode) {
 
 /***********************************************************************
 **
-*/	void Decode_LZW(REBCNT *data, REBYTE **cpp, REBYTE *colortab, REBINT w, REBINT h, REBOOL interlaced)
+*/	void Decode_LZW(REBCNT *data, REBYTE **cpp, REBYTE *colortab, REBINT w, REBINT h, REBOOL interlaced, REBCDI *codi)
 /*
 **	Perform LZW decompression.
 **
+**	If codi is given, data holds one row, and each row is passed to
+**	the codec rows callback as it is completed (not interlaced).
+**
 ***********************************************************************/
 {
 	REBYTE	*cp = *cpp;
@@ -182,7 +185,11 @@ void Chrom_Key_Alpha(REBVAL *v,REBCNT col,REBINT blitmode) {
 			*dp++ = TO_PIXEL_COLOR(rp[0], rp[1], rp[2], 0xff);
 			x++;
 		}
-		if (interlaced) {
+		if (codi) {
+			if (codi->rows(codi, y, 1, data)) break;
+			dp = data;
+		}
+		else if (interlaced) {
 			row += interlace_rate[i];
 			if (row >= h) {
 				row = interlace_start[++i];
@@ -214,6 +221,7 @@ void Chrom_Key_Alpha(REBVAL *v,REBCNT col,REBINT blitmode) {
 	REBYTE	*cp;
 	REBCNT	*dp;
 	REBOOL	interlaced;
+	REBOOL	stream;
 	REBYTE	*end;
 
 	cp  = codi->data;
@@ -295,11 +303,22 @@ void Chrom_Key_Alpha(REBVAL *v,REBCNT col,REBINT blitmode) {
 			Append_Series(VAL_SERIES(Temp2_Value), (REBMEM *)Temp_Value, 1);
 		}
 */
-		dp = codi->bits = Make_Mem(w * h * 4);
+		// Rows of an interlaced image are not in order, so it is
+		// decoded in full. Row decoding stops at the first image.
+		stream = codi->action == CODI_DECODE_ROWS && !interlaced;
+		dp = codi->bits = Make_Mem(w * (stream ? 1 : h) * 4);
 		codi->w = w;
 		codi->h = h;
 
-		Decode_LZW(dp, &cp, colormap, w, h, interlaced);
+		Decode_LZW(dp, &cp, colormap, w, h, interlaced, stream ? codi : 0);
+
+		if (codi->action == CODI_DECODE_ROWS) {
+			if (stream) {
+				Free_Mem(codi->bits, w * 4);
+				codi->bits = 0;
+			}
+			return;
+		}
 
 		if(transparency_index >= 0) {
 			int ADD_alpha_key_detection;
@@ -328,7 +347,7 @@ void Chrom_Key_Alpha(REBVAL *v,REBCNT col,REBINT blitmode) {
 		return CODI_CHECK; // error code is inverted result
 	}
 
-	if (codi->action == CODI_DECODE) {
+	if (codi->action == CODI_DECODE || codi->action == CODI_DECODE_ROWS) {
 		Decode_GIF_Image(codi);
 		return CODI_IMAGE;
 	}
@@ -6726,6 +6726,294 @@ jpeg_idct_islow (j_decompress_ptr cinfo, jpeg_component_info * compptr,
 }
 
 #endif /* DCT_ISLOW_SUPPORTED */
+/*
+ * jidctred.c
+ *
+ * This file contains inverse-DCT routines that produce reduced-size output:
+ * either 4x4, 2x2, or 1x1 pixels from an 8x8 DCT block.  They let the
+ * decoder scale an image down by 2, 4 or 8 (scale_num/scale_denom) for
+ * roughly the price of the entropy decoding alone.
+ *
+ * The output is the full 8x8 IDCT followed by averaging each 2x2, 4x4 or
+ * 8x8 group of pixels, folded into the transform itself.  Averaging a pair
+ * of samples of the 8-point basis function u gives the 4-point basis
+ * function scaled by cos(u*pi/16), and coefficient 4 cancels out; averaging
+ * four samples cancels all the even coefficients but the DC term.  So the
+ * 4x4 transform ignores row and column 4, the 2x2 transform uses only
+ * coefficients 0,1,3,5,7, and the 1x1 transform is the DC value alone.
+ *
+ * The constants below include the 1-D normalization C(u)/2 as well, so
+ * each pass yields true (not sqrt(8) scaled) values and the descaling
+ * shifts are just CONST_BITS and PASS1_BITS.
+ */
+
+#define JPEG_INTERNALS
+
+#ifdef IDCT_SCALING_SUPPORTED
+
+
+#undef CONST_BITS
+#undef PASS1_BITS
+#define CONST_BITS  13
+#define PASS1_BITS  2
+
+#if CONST_BITS == 13
+#define FIX_0_037328917  ((INT32)  306)		/* FIX(0.037328917) */
+#define FIX_0_063724447  ((INT32)  522)		/* FIX(0.063724447) */
+#define FIX_0_075168111  ((INT32)  616)		/* FIX(0.075168111) */
+#define FIX_0_090119978  ((INT32)  738)		/* FIX(0.090119978) */
+#define FIX_0_106303762  ((INT32)  871)		/* FIX(0.106303762) */
+#define FIX_0_112497028  ((INT32)  922)		/* FIX(0.112497028) */
+#define FIX_0_135299025  ((INT32)  1108)	/* FIX(0.135299025) */
+#define FIX_0_159094823  ((INT32)  1303)	/* FIX(0.159094823) */
+#define FIX_0_187665139  ((INT32)  1537)	/* FIX(0.187665139) */
+#define FIX_0_256639984  ((INT32)  2102)	/* FIX(0.256639984) */
+#define FIX_0_320364431  ((INT32)  2624)	/* FIX(0.320364431) */
+#define FIX_0_326640741  ((INT32)  2676)	/* FIX(0.326640741) */
+#define FIX_0_353553391  ((INT32)  2896)	/* FIX(0.353553391) */
+#define FIX_0_384088879  ((INT32)  3146)	/* FIX(0.384088879) */
+#define FIX_0_453063723  ((INT32)  3711)	/* FIX(0.453063723) */
+#else
+#define FIX_0_037328917  FIX(0.037328917)
+#define FIX_0_063724447  FIX(0.063724447)
+#define FIX_0_075168111  FIX(0.075168111)
+#define FIX_0_090119978  FIX(0.090119978)
+#define FIX_0_106303762  FIX(0.106303762)
+#define FIX_0_112497028  FIX(0.112497028)
+#define FIX_0_135299025  FIX(0.135299025)
+#define FIX_0_159094823  FIX(0.159094823)
+#define FIX_0_187665139  FIX(0.187665139)
+#define FIX_0_256639984  FIX(0.256639984)
+#define FIX_0_320364431  FIX(0.320364431)
+#define FIX_0_326640741  FIX(0.326640741)
+#define FIX_0_353553391  FIX(0.353553391)
+#define FIX_0_384088879  FIX(0.384088879)
+#define FIX_0_453063723  FIX(0.453063723)
+#endif
+
+
+/* Dequantized coefficients can exceed 16 bits once multiplied by these
+ * constants, so always use a full 32-bit multiply here.
+ */
+
+#define jidctr_MULTIPLY(var,const)  (((INT32) (var)) * (const))
+
+#define jidctr_DEQUANTIZE(coef,quantval)  (((ISLOW_MULT_TYPE) (coef)) * (quantval))
+
+
+/* 4-point reduced IDCT of one column or row; in[] is indexed by u*step.
+ * The even part is K0*y0 +/- (K2*y2 - K6*y6); the odd part gives the
+ * outputs in mirrored pairs (0,3) and (1,2).
+ */
+
+#define jidctr_IDCT4(y0,y1,y2,y3,y5,y6,y7, o0,o1,o2,o3) { \
+    tmp0 = jidctr_MULTIPLY(y0, FIX_0_353553391); \
+    tmp2 = jidctr_MULTIPLY(y2, FIX_0_326640741) - \
+	   jidctr_MULTIPLY(y6, FIX_0_135299025); \
+    tmp10 = tmp0 + tmp2; \
+    tmp12 = tmp0 - tmp2; \
+    tmp0 = jidctr_MULTIPLY(y1, FIX_0_453063723) + \
+	   jidctr_MULTIPLY(y3, FIX_0_159094823) - \
+	   jidctr_MULTIPLY(y5, FIX_0_106303762) - \
+	   jidctr_MULTIPLY(y7, FIX_0_090119978); \
+    tmp2 = jidctr_MULTIPLY(y1, FIX_0_187665139) - \
+	   jidctr_MULTIPLY(y3, FIX_0_384088879) + \
+	   jidctr_MULTIPLY(y5, FIX_0_256639984) - \
+	   jidctr_MULTIPLY(y7, FIX_0_037328917); \
+    o0 = tmp10 + tmp0; \
+    o3 = tmp10 - tmp0; \
+    o1 = tmp12 + tmp2; \
+    o2 = tmp12 - tmp2; \
+}
+
+
+/*
+ * Perform dequantization and inverse DCT on one block of coefficients,
+ * producing a reduced-size 4x4 output block.
+ */
+
+GLOBAL(void)
+jpeg_idct_4x4 (j_decompress_ptr cinfo, jpeg_component_info * compptr,
+	       JCOEFPTR coef_block,
+	       JSAMPARRAY output_buf, JDIMENSION output_col)
+{
+  INT32 tmp0, tmp2, tmp10, tmp12;
+  INT32 out0, out1, out2, out3;
+  JCOEFPTR inptr;
+  ISLOW_MULT_TYPE * quantptr;
+  int * wsptr;
+  JSAMPROW outptr;
+  JSAMPLE *range_limit = IDCT_range_limit(cinfo);
+  int ctr;
+  int workspace[DCTSIZE*4];	/* buffers data between passes */
+
+  /* Pass 1: process columns from input, store into work array. */
+
+  inptr = coef_block;
+  quantptr = (ISLOW_MULT_TYPE *) compptr->dct_table;
+  wsptr = workspace;
+  for (ctr = DCTSIZE; ctr > 0; inptr++, quantptr++, wsptr++, ctr--) {
+    /* Don't bother to process column 4, because second pass won't use it */
+    if (ctr == DCTSIZE-4)
+      continue;
+    if (inptr[DCTSIZE*1] == 0 && inptr[DCTSIZE*2] == 0 &&
+	inptr[DCTSIZE*3] == 0 && inptr[DCTSIZE*5] == 0 &&
+	inptr[DCTSIZE*6] == 0 && inptr[DCTSIZE*7] == 0) {
+      /* AC terms all zero; we need not examine term 4 for 4x4 output */
+      int dcval = (int) DESCALE(jidctr_MULTIPLY(jidctr_DEQUANTIZE(inptr[0],
+		    quantptr[0]), FIX_0_353553391), CONST_BITS-PASS1_BITS);
+
+      wsptr[DCTSIZE*0] = dcval;
+      wsptr[DCTSIZE*1] = dcval;
+      wsptr[DCTSIZE*2] = dcval;
+      wsptr[DCTSIZE*3] = dcval;
+
+      continue;
+    }
+
+    jidctr_IDCT4(jidctr_DEQUANTIZE(inptr[DCTSIZE*0], quantptr[DCTSIZE*0]),
+		 jidctr_DEQUANTIZE(inptr[DCTSIZE*1], quantptr[DCTSIZE*1]),
+		 jidctr_DEQUANTIZE(inptr[DCTSIZE*2], quantptr[DCTSIZE*2]),
+		 jidctr_DEQUANTIZE(inptr[DCTSIZE*3], quantptr[DCTSIZE*3]),
+		 jidctr_DEQUANTIZE(inptr[DCTSIZE*5], quantptr[DCTSIZE*5]),
+		 jidctr_DEQUANTIZE(inptr[DCTSIZE*6], quantptr[DCTSIZE*6]),
+		 jidctr_DEQUANTIZE(inptr[DCTSIZE*7], quantptr[DCTSIZE*7]),
+		 out0, out1, out2, out3);
+
+    wsptr[DCTSIZE*0] = (int) DESCALE(out0, CONST_BITS-PASS1_BITS);
+    wsptr[DCTSIZE*1] = (int) DESCALE(out1, CONST_BITS-PASS1_BITS);
+    wsptr[DCTSIZE*2] = (int) DESCALE(out2, CONST_BITS-PASS1_BITS);
+    wsptr[DCTSIZE*3] = (int) DESCALE(out3, CONST_BITS-PASS1_BITS);
+  }
+
+  /* Pass 2: process 4 rows from work array, store into output array. */
+
+  wsptr = workspace;
+  for (ctr = 0; ctr < 4; ctr++) {
+    outptr = output_buf[ctr] + output_col;
+
+    jidctr_IDCT4(wsptr[0], wsptr[1], wsptr[2], wsptr[3],
+		 wsptr[5], wsptr[6], wsptr[7],
+		 out0, out1, out2, out3);
+
+    outptr[0] = range_limit[(int) DESCALE(out0, CONST_BITS+PASS1_BITS)
+			    & RANGE_MASK];
+    outptr[1] = range_limit[(int) DESCALE(out1, CONST_BITS+PASS1_BITS)
+			    & RANGE_MASK];
+    outptr[2] = range_limit[(int) DESCALE(out2, CONST_BITS+PASS1_BITS)
+			    & RANGE_MASK];
+    outptr[3] = range_limit[(int) DESCALE(out3, CONST_BITS+PASS1_BITS)
+			    & RANGE_MASK];
+
+    wsptr += DCTSIZE;		/* advance pointer to next row */
+  }
+}
+
+
+/*
+ * Perform dequantization and inverse DCT on one block of coefficients,
+ * producing a reduced-size 2x2 output block.
+ */
+
+GLOBAL(void)
+jpeg_idct_2x2 (j_decompress_ptr cinfo, jpeg_component_info * compptr,
+	       JCOEFPTR coef_block,
+	       JSAMPARRAY output_buf, JDIMENSION output_col)
+{
+  INT32 tmp0, tmp10;
+  JCOEFPTR inptr;
+  ISLOW_MULT_TYPE * quantptr;
+  int * wsptr;
+  JSAMPROW outptr;
+  JSAMPLE *range_limit = IDCT_range_limit(cinfo);
+  int ctr;
+  int workspace[DCTSIZE*2];	/* buffers data between passes */
+
+  /* Pass 1: process columns from input, store into work array. */
+
+  inptr = coef_block;
+  quantptr = (ISLOW_MULT_TYPE *) compptr->dct_table;
+  wsptr = workspace;
+  for (ctr = DCTSIZE; ctr > 0; inptr++, quantptr++, wsptr++, ctr--) {
+    /* Don't bother to process columns 2,4,6 */
+    if (ctr == DCTSIZE-2 || ctr == DCTSIZE-4 || ctr == DCTSIZE-6)
+      continue;
+
+    tmp10 = jidctr_MULTIPLY(jidctr_DEQUANTIZE(inptr[DCTSIZE*0],
+			    quantptr[DCTSIZE*0]), FIX_0_353553391);
+
+    if (inptr[DCTSIZE*1] == 0 && inptr[DCTSIZE*3] == 0 &&
+	inptr[DCTSIZE*5] == 0 && inptr[DCTSIZE*7] == 0) {
+      /* AC terms all zero; we need not examine terms 2,4,6 for 2x2 output */
+      int dcval = (int) DESCALE(tmp10, CONST_BITS-PASS1_BITS);
+
+      wsptr[DCTSIZE*0] = dcval;
+      wsptr[DCTSIZE*1] = dcval;
+
+      continue;
+    }
+
+    /* Odd part */
+
+    tmp0 = jidctr_MULTIPLY(jidctr_DEQUANTIZE(inptr[DCTSIZE*1],
+			   quantptr[DCTSIZE*1]), FIX_0_320364431) -
+	   jidctr_MULTIPLY(jidctr_DEQUANTIZE(inptr[DCTSIZE*3],
+			   quantptr[DCTSIZE*3]), FIX_0_112497028) +
+	   jidctr_MULTIPLY(jidctr_DEQUANTIZE(inptr[DCTSIZE*5],
+			   quantptr[DCTSIZE*5]), FIX_0_075168111) -
+	   jidctr_MULTIPLY(jidctr_DEQUANTIZE(inptr[DCTSIZE*7],
+			   quantptr[DCTSIZE*7]), FIX_0_063724447);
+
+    wsptr[DCTSIZE*0] = (int) DESCALE(tmp10 + tmp0, CONST_BITS-PASS1_BITS);
+    wsptr[DCTSIZE*1] = (int) DESCALE(tmp10 - tmp0, CONST_BITS-PASS1_BITS);
+  }
+
+  /* Pass 2: process 2 rows from work array, store into output array. */
+
+  wsptr = workspace;
+  for (ctr = 0; ctr < 2; ctr++) {
+    outptr = output_buf[ctr] + output_col;
+
+    tmp10 = jidctr_MULTIPLY(wsptr[0], FIX_0_353553391);
+
+    tmp0 = jidctr_MULTIPLY(wsptr[1], FIX_0_320364431) -
+	   jidctr_MULTIPLY(wsptr[3], FIX_0_112497028) +
+	   jidctr_MULTIPLY(wsptr[5], FIX_0_075168111) -
+	   jidctr_MULTIPLY(wsptr[7], FIX_0_063724447);
+
+    outptr[0] = range_limit[(int) DESCALE(tmp10 + tmp0, CONST_BITS+PASS1_BITS)
+			    & RANGE_MASK];
+    outptr[1] = range_limit[(int) DESCALE(tmp10 - tmp0, CONST_BITS+PASS1_BITS)
+			    & RANGE_MASK];
+
+    wsptr += DCTSIZE;		/* advance pointer to next row */
+  }
+}
+
+
+/*
+ * Perform dequantization and inverse DCT on one block of coefficients,
+ * producing a reduced-size 1x1 output block.
+ */
+
+GLOBAL(void)
+jpeg_idct_1x1 (j_decompress_ptr cinfo, jpeg_component_info * compptr,
+	       JCOEFPTR coef_block,
+	       JSAMPARRAY output_buf, JDIMENSION output_col)
+{
+  int dcval;
+  ISLOW_MULT_TYPE * quantptr;
+  JSAMPLE *range_limit = IDCT_range_limit(cinfo);
+
+  /* The average of the block is the DC term alone, divided by 8. */
+  quantptr = (ISLOW_MULT_TYPE *) compptr->dct_table;
+  dcval = jidctr_DEQUANTIZE(coef_block[0], quantptr[0]);
+  dcval = (int) DESCALE((INT32) dcval, 3);
+
+  output_buf[0][output_col] = range_limit[dcval & RANGE_MASK];
+}
+
+#endif /* IDCT_SCALING_SUPPORTED */
 /*
  * jdsample.c
  *
@@ -10787,6 +11075,70 @@ extern long* Make_Mem(size_t size);
 extern void Register_Codec(char *name, codo dispatcher);
 #endif
 
+/***********************************************************************
+**
+*/	static void Decode_JPEG_Rows(REBCDI *codi)
+/*
+**		Pass scanlines to the rows callback as they are decoded.
+**		Scaling by 2, 4 or 8 is done by the IDCT itself (the largest
+**		of these that divides codi->scale), so a thumbnail costs
+**		little more than the entropy decoding.
+**
+***********************************************************************/
+{
+  struct jpeg_decompress_struct cinfo;
+  struct jpeg_error_mgr jerr;
+  JSAMPARRAY row;
+  unsigned char *cp;
+  unsigned int *dp, c;
+  unsigned int y, j;
+
+  cinfo.err = jpeg_std_error(&jerr);
+  jpeg_create_decompress(&cinfo);
+  jpeg_series_src(&cinfo, (unsigned char *)codi->data, codi->len);
+  (void) jpeg_read_header(&cinfo, TRUE);
+
+  cinfo.scale_num = 1;
+  cinfo.scale_denom = 1;
+  while (cinfo.scale_denom < 8 && codi->scale % (cinfo.scale_denom * 2) == 0)
+	cinfo.scale_denom *= 2;
+
+  (void) jpeg_start_decompress(&cinfo);
+  codi->w = cinfo.output_width;
+  codi->h = cinfo.output_height;
+  codi->scaled = cinfo.scale_denom;
+
+  // One row, wide enough to expand to four byte pixels in place:
+  row = (*cinfo.mem->alloc_sarray)((j_common_ptr) &cinfo, JPOOL_IMAGE,
+	cinfo.output_width * 4, 1);
+
+  while (cinfo.output_scanline < cinfo.output_height) {
+	y = cinfo.output_scanline;
+	jpeg_read_scanlines(&cinfo, row, 1);
+	dp = (unsigned int *)row[0] + cinfo.output_width;
+	if (cinfo.out_color_space != JCS_GRAYSCALE) {
+	  cp = row[0] + cinfo.output_width * 3;
+	  for (j = 0; j < cinfo.output_width; j++) {
+		cp -= 3;
+		*--dp = TO_PIXEL_COLOR(cp[0], cp[1], cp[2], 0xff);
+	  }
+	}
+	else {
+	  cp = row[0] + cinfo.output_width;
+	  for (j = 0; j < cinfo.output_width; j++) {
+		c = *--cp;
+		*--dp = TO_PIXEL_COLOR(c, c, c, 0xff);
+	  }
+	}
+	if (codi->rows(codi, y, 1, (unsigned int *)row[0])) break;
+  }
+
+  if (cinfo.output_scanline >= cinfo.output_height)
+	(void) jpeg_finish_decompress(&cinfo);
+  jpeg_destroy_decompress(&cinfo);
+}
+
+
 /***********************************************************************
 **
 */	int Codec_JPEG_Image(REBCDI *codi)
@@ -10818,6 +11170,11 @@ extern void Register_Codec(char *name, codo dispatcher);
 		return CODI_IMAGE;
 	}
 
+	if (codi->action == CODI_DECODE_ROWS) {
+		Decode_JPEG_Rows(codi);
+		return CODI_IMAGE;
+	}
+
 	codi->error = CODI_ERR_NA;
 	return CODI_ERROR;
 }
@@ -540,7 +540,7 @@ int png_info(unsigned char *buffer, int nbytes, int *w, int *h) {
 	return 1;
 }
 
-void png_load(unsigned char *buffer, int nbytes, char *output, REBOOL *alpha) {
+void png_load(unsigned char *buffer, int nbytes, char *output, REBOOL *alpha, REBCDI *codi) {
 	unsigned char *p;
 	int length,ret,adam7pass;
 	int awidth,aheight,r,comp_awidth;
@@ -603,11 +603,13 @@ void png_load(unsigned char *buffer, int nbytes, char *output, REBOOL *alpha) {
 			 adam7hskip[adam7pass],adam7voff[adam7pass],adam7vskip[adam7pass]);
 		}
 	} else {
-		imgbuffer=malloc(rowlength*(png_ihdr.height+1));
+		// Only the previous and the current raw rows are kept. With
+		// codi, output holds one row and is passed to the rows callback.
+		imgbuffer=malloc(rowlength*2);
 		comp_awidth=1+(png_ihdr.width*bitsperpixel+7)/8;
-		memset(imgbuffer,0,rowlength);
-		for(r=1;r<=(int)png_ihdr.height;r++) {
-			zstream.next_out=imgbuffer+r*rowlength+bytesperpixel-1;
+		memset(imgbuffer,0,rowlength*2);
+		for(r=0;r<(int)png_ihdr.height;r++) {
+			zstream.next_out=imgbuffer+rowlength+bytesperpixel-1;
 			zstream.avail_out=comp_awidth;
 			while(1) {
 				ret=inflate(&zstream,0);
@@ -623,8 +625,11 @@ void png_load(unsigned char *buffer, int nbytes, char *output, REBOOL *alpha) {
 				}
 				goto error;
 			}
+			process_image(png_ihdr.width,1,comp_awidth-1,0,1,codi?0:r,1);
+			if(codi&&codi->rows(codi,r,1,img_output))
+				break;
+			memcpy(imgbuffer,imgbuffer+rowlength,rowlength);
 		}
-		process_image(png_ihdr.width,png_ihdr.height,comp_awidth-1,0,1,0,1);
 	}
 	free(imgbuffer);
 	inflateEnd(&zstream);
@@ -802,12 +807,20 @@ error:
 {
 	int w, h;
 	REBOOL alpha = 0;
+	REBOOL stream;
 
 	if (!png_info(codi->data, codi->len, &w, &h )) trap_png();
 	codi->w = w;
 	codi->h = h;
-	codi->bits = Make_Mem(w * h * 4);
-	png_load((unsigned char *)(codi->data), codi->len, (unsigned char *)(codi->bits), &alpha);
+
+	// Interlaced images are decoded in full, even for CODI_DECODE_ROWS:
+	stream = codi->action == CODI_DECODE_ROWS && !png_ihdr.interlace_method;
+	codi->bits = Make_Mem(w * (stream ? 1 : h) * 4);
+	png_load((unsigned char *)(codi->data), codi->len, (unsigned char *)(codi->bits), &alpha, stream ? codi : 0);
+	if (stream) {
+		Free_Mem(codi->bits, w * 4);
+		codi->bits = 0;
+	}
 
 	//if(alpha) VAL_IMAGE_TRANSP(Temp_Value)=VITT_ALPHA;
 }
@@ -833,7 +846,7 @@ error:
 		return CODI_CHECK; // error code is inverted result
 	}
 
-	if (codi->action == CODI_DECODE) {
+	if (codi->action == CODI_DECODE || codi->action == CODI_DECODE_ROWS) {
 		Decode_PNG_Image(codi);
 		return CODI_IMAGE;
 	}
@@ -61,6 +61,10 @@
 #include <string.h>
 #include "sys-core.h"
 
+#ifdef HAS_CPU_FEATURES
+#include <immintrin.h>
+#endif
+
 #if !defined(ENDIAN_LITTLE) && !defined(ENDIAN_BIG)
 #error Endianness must be defined in rebol.h for builds including SHA1
 #endif
@@ -313,6 +317,80 @@ unsigned long __builtin_rol(unsigned long,int,int);
 #  define	M_nl2c		nl2c
 #endif
 
+#ifdef HAS_CPU_FEATURES
+/***********************************************************************
+**
+**	SHA-1 with the x86 SHA extensions (when the CPU has them)
+**
+***********************************************************************/
+
+#define SHA1_NI_ROUNDS(en, eo, m, f) \
+	en = _mm_sha1nexte_epu32(en, m); eo = abcd; abcd = _mm_sha1rnds4_epu32(abcd, en, f);
+#define SHA1_NI_MSG1(m, n)	m = _mm_sha1msg1_epu32(m, n);
+#define SHA1_NI_MSG2(m, n)	m = _mm_sha1msg2_epu32(m, n);
+#define SHA1_NI_XOR(m, n)	m = _mm_xor_si128(m, n);
+
+static void SHA1_Blocks_NI(SHA_CTX *c, REBYTE *data, REBCNT len) __attribute__((target("sha,ssse3,sse4.1")));
+
+/***********************************************************************
+**
+*/	static void SHA1_Blocks_NI(SHA_CTX *c, REBYTE *data, REBCNT len)
+/*
+**		Hash len bytes (whole 64 byte blocks). Each group of lines
+**		below does four rounds, and expands the message schedule
+**		for the groups that follow.
+**
+***********************************************************************/
+{
+	__m128i abcd, abcd_save, e0, e0_save, e1;
+	__m128i m0, m1, m2, m3;
+	__m128i swap = _mm_set_epi8(0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15);
+
+	abcd = _mm_set_epi32((int)c->h0, (int)c->h1, (int)c->h2, (int)c->h3);
+	e0 = _mm_set_epi32((int)c->h4, 0, 0, 0);
+
+	for (; len >= SHA_CBLOCK; data += SHA_CBLOCK, len -= SHA_CBLOCK) {
+		abcd_save = abcd;
+		e0_save = e0;
+
+		m0 = _mm_shuffle_epi8(_mm_loadu_si128((__m128i*)(data + 0)), swap);
+		m1 = _mm_shuffle_epi8(_mm_loadu_si128((__m128i*)(data + 16)), swap);
+		m2 = _mm_shuffle_epi8(_mm_loadu_si128((__m128i*)(data + 32)), swap);
+		m3 = _mm_shuffle_epi8(_mm_loadu_si128((__m128i*)(data + 48)), swap);
+
+		e0 = _mm_add_epi32(e0, m0); e1 = abcd; abcd = _mm_sha1rnds4_epu32(abcd, e0, 0);
+		SHA1_NI_ROUNDS(e1, e0, m1, 0); SHA1_NI_MSG1(m0, m1)
+		SHA1_NI_ROUNDS(e0, e1, m2, 0); SHA1_NI_MSG1(m1, m2) SHA1_NI_XOR(m0, m2)
+		SHA1_NI_ROUNDS(e1, e0, m3, 0); SHA1_NI_MSG1(m2, m3) SHA1_NI_XOR(m1, m3) SHA1_NI_MSG2(m0, m3)
+		SHA1_NI_ROUNDS(e0, e1, m0, 0); SHA1_NI_MSG1(m3, m0) SHA1_NI_XOR(m2, m0) SHA1_NI_MSG2(m1, m0)
+		SHA1_NI_ROUNDS(e1, e0, m1, 1); SHA1_NI_MSG1(m0, m1) SHA1_NI_XOR(m3, m1) SHA1_NI_MSG2(m2, m1)
+		SHA1_NI_ROUNDS(e0, e1, m2, 1); SHA1_NI_MSG1(m1, m2) SHA1_NI_XOR(m0, m2) SHA1_NI_MSG2(m3, m2)
+		SHA1_NI_ROUNDS(e1, e0, m3, 1); SHA1_NI_MSG1(m2, m3) SHA1_NI_XOR(m1, m3) SHA1_NI_MSG2(m0, m3)
+		SHA1_NI_ROUNDS(e0, e1, m0, 1); SHA1_NI_MSG1(m3, m0) SHA1_NI_XOR(m2, m0) SHA1_NI_MSG2(m1, m0)
+		SHA1_NI_ROUNDS(e1, e0, m1, 1); SHA1_NI_MSG1(m0, m1) SHA1_NI_XOR(m3, m1) SHA1_NI_MSG2(m2, m1)
+		SHA1_NI_ROUNDS(e0, e1, m2, 2); SHA1_NI_MSG1(m1, m2) SHA1_NI_XOR(m0, m2) SHA1_NI_MSG2(m3, m2)
+		SHA1_NI_ROUNDS(e1, e0, m3, 2); SHA1_NI_MSG1(m2, m3) SHA1_NI_XOR(m1, m3) SHA1_NI_MSG2(m0, m3)
+		SHA1_NI_ROUNDS(e0, e1, m0, 2); SHA1_NI_MSG1(m3, m0) SHA1_NI_XOR(m2, m0) SHA1_NI_MSG2(m1, m0)
+		SHA1_NI_ROUNDS(e1, e0, m1, 2); SHA1_NI_MSG1(m0, m1) SHA1_NI_XOR(m3, m1) SHA1_NI_MSG2(m2, m1)
+		SHA1_NI_ROUNDS(e0, e1, m2, 2); SHA1_NI_MSG1(m1, m2) SHA1_NI_XOR(m0, m2) SHA1_NI_MSG2(m3, m2)
+		SHA1_NI_ROUNDS(e1, e0, m3, 3); SHA1_NI_MSG1(m2, m3) SHA1_NI_XOR(m1, m3) SHA1_NI_MSG2(m0, m3)
+		SHA1_NI_ROUNDS(e0, e1, m0, 3); SHA1_NI_MSG1(m3, m0) SHA1_NI_XOR(m2, m0) SHA1_NI_MSG2(m1, m0)
+		SHA1_NI_ROUNDS(e1, e0, m1, 3); SHA1_NI_XOR(m3, m1) SHA1_NI_MSG2(m2, m1)
+		SHA1_NI_ROUNDS(e0, e1, m2, 3); SHA1_NI_MSG2(m3, m2)
+		SHA1_NI_ROUNDS(e1, e0, m3, 3);
+
+		e0 = _mm_sha1nexte_epu32(e0, e0_save);
+		abcd = _mm_add_epi32(abcd, abcd_save);
+	}
+
+	c->h0 = (u32)_mm_extract_epi32(abcd, 3);
+	c->h1 = (u32)_mm_extract_epi32(abcd, 2);
+	c->h2 = (u32)_mm_extract_epi32(abcd, 1);
+	c->h3 = (u32)_mm_extract_epi32(abcd, 0);
+	c->h4 = (u32)_mm_extract_epi32(e0, 3);
+}
+#endif
+
 void SHA1_Init(c)
 SHA_CTX *c;
 	{
@@ -410,6 +488,15 @@ unsigned long len;
 			len-=sw;
 			}
 		}
+#endif
+#ifdef HAS_CPU_FEATURES
+	if (len >= SHA_CBLOCK && (CPU_Features() & CPU_SHA))
+		{
+		l=len&~(unsigned long)(SHA_CBLOCK-1);
+		SHA1_Blocks_NI(c,data,l);
+		data+=l;
+		len-=l;
+		}
 #endif
 	/* we now can process the input data in blocks of SHA_CBLOCK
 	 * chars and save the leftovers to c->data. */
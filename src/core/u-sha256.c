@@ -0,0 +1,301 @@
+/***********************************************************************
+**
+**  REBOL [R3] Language Interpreter and Run-time Environment
+**
+**  Copyright 2012 REBOL Technologies
+**  REBOL is a trademark of REBOL Technologies
+**
+**  Licensed under the Apache License, Version 2.0 (the "License");
+**  you may not use this file except in compliance with the License.
+**  You may obtain a copy of the License at
+**
+**  http://www.apache.org/licenses/LICENSE-2.0
+**
+**  Unless required by applicable law or agreed to in writing, software
+**  distributed under the License is distributed on an "AS IS" BASIS,
+**  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**  See the License for the specific language governing permissions and
+**  limitations under the License.
+**
+************************************************************************
+**
+**  Module:  u-sha256.c
+**  Summary: SHA-256 secure hash (FIPS 180-4)
+**  Section: utility
+**  Notes:
+**    Uses the x86 SHA extensions when the CPU has them (see
+**    CPU_Features), otherwise portable C. The context functions
+**    have the same form as SHA1 and MD5 for the digests[] table.
+**
+***********************************************************************/
+
+#include "sys-core.h"
+
+#ifdef HAS_CPU_FEATURES
+#include <immintrin.h>
+#endif
+
+#define SHA256_BLOCK	64
+#define SHA256_DIGEST	32
+
+typedef struct rebol_sha256_ctx {
+	REBCNT state[8];
+	REBU64 bits;				// message length in bits
+	REBYTE block[SHA256_BLOCK];	// partial block
+	REBCNT num;					// bytes in partial block
+} SHA256_CTX;
+
+static const REBCNT K256[64] = {
+	0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+	0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+	0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+	0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+	0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+	0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+	0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+	0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+#define ROR32(x, n)	(((x) >> (n)) | ((x) << (32 - (n))))
+#define BIG32(p)	(((REBCNT)(p)[0] << 24) | ((REBCNT)(p)[1] << 16) | ((REBCNT)(p)[2] << 8) | (p)[3])
+
+
+/***********************************************************************
+**
+*/	static void SHA256_Blocks(REBCNT *state, REBYTE *data, REBCNT len)
+/*
+**		Hash len bytes (whole 64 byte blocks) in portable C.
+**
+***********************************************************************/
+{
+	REBCNT w[64];
+	REBCNT a, b, c, d, e, f, g, h, t1, t2;
+	int i;
+
+	for (; len >= SHA256_BLOCK; data += SHA256_BLOCK, len -= SHA256_BLOCK) {
+		for (i = 0; i < 16; i++) w[i] = BIG32(data + i * 4);
+		for (; i < 64; i++) {
+			t1 = w[i-2];
+			t2 = w[i-15];
+			w[i] = (ROR32(t1, 17) ^ ROR32(t1, 19) ^ (t1 >> 10)) + w[i-7]
+				 + (ROR32(t2, 7) ^ ROR32(t2, 18) ^ (t2 >> 3)) + w[i-16];
+		}
+
+		a = state[0]; b = state[1]; c = state[2]; d = state[3];
+		e = state[4]; f = state[5]; g = state[6]; h = state[7];
+
+		for (i = 0; i < 64; i++) {
+			t1 = h + (ROR32(e, 6) ^ ROR32(e, 11) ^ ROR32(e, 25)) + ((e & f) ^ (~e & g)) + K256[i] + w[i];
+			t2 = (ROR32(a, 2) ^ ROR32(a, 13) ^ ROR32(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+			h = g; g = f; f = e; e = d + t1;
+			d = c; c = b; b = a; a = t1 + t2;
+		}
+
+		state[0] += a; state[1] += b; state[2] += c; state[3] += d;
+		state[4] += e; state[5] += f; state[6] += g; state[7] += h;
+	}
+}
+
+
+#ifdef HAS_CPU_FEATURES
+
+// Four rounds, using message words m (plus constants):
+#define SHA256_NI_ROUNDS(g, m) \
+	msg = _mm_add_epi32(m, _mm_loadu_si128((__m128i*)&K256[(g)*4])); \
+	cdgh = _mm_sha256rnds2_epu32(cdgh, abef, msg); \
+	msg = _mm_shuffle_epi32(msg, 0x0E); \
+	abef = _mm_sha256rnds2_epu32(abef, cdgh, msg);
+
+// Finish the next message words mn from the current mc and prior mp:
+#define SHA256_NI_MSG2(mn, mc, mp) \
+	mn = _mm_add_epi32(mn, _mm_alignr_epi8(mc, mp, 4)); \
+	mn = _mm_sha256msg2_epu32(mn, mc);
+
+#define SHA256_NI_MSG1(mp, mc)	mp = _mm_sha256msg1_epu32(mp, mc);
+
+static void SHA256_Blocks_NI(REBCNT *state, REBYTE *data, REBCNT len) __attribute__((target("sha,ssse3,sse4.1")));
+
+/***********************************************************************
+**
+*/	static void SHA256_Blocks_NI(REBCNT *state, REBYTE *data, REBCNT len)
+/*
+**		Hash len bytes (whole 64 byte blocks) with the SHA extensions.
+**		The instructions keep the state as ABEF and CDGH halves.
+**
+***********************************************************************/
+{
+	__m128i abef, cdgh, abef_save, cdgh_save, msg, tmp;
+	__m128i m0, m1, m2, m3;
+	__m128i swap = _mm_set_epi8(12,13,14,15, 8,9,10,11, 4,5,6,7, 0,1,2,3);
+
+	tmp  = _mm_shuffle_epi32(_mm_loadu_si128((__m128i*)&state[0]), 0xB1);	// CDAB
+	cdgh = _mm_shuffle_epi32(_mm_loadu_si128((__m128i*)&state[4]), 0x1B);	// EFGH
+	abef = _mm_alignr_epi8(tmp, cdgh, 8);
+	cdgh = _mm_blend_epi16(cdgh, tmp, 0xF0);
+
+	for (; len >= SHA256_BLOCK; data += SHA256_BLOCK, len -= SHA256_BLOCK) {
+		abef_save = abef;
+		cdgh_save = cdgh;
+
+		m0 = _mm_shuffle_epi8(_mm_loadu_si128((__m128i*)(data + 0)), swap);
+		m1 = _mm_shuffle_epi8(_mm_loadu_si128((__m128i*)(data + 16)), swap);
+		m2 = _mm_shuffle_epi8(_mm_loadu_si128((__m128i*)(data + 32)), swap);
+		m3 = _mm_shuffle_epi8(_mm_loadu_si128((__m128i*)(data + 48)), swap);
+
+		SHA256_NI_ROUNDS( 0, m0)
+		SHA256_NI_ROUNDS( 1, m1) SHA256_NI_MSG1(m0, m1)
+		SHA256_NI_ROUNDS( 2, m2) SHA256_NI_MSG1(m1, m2)
+		SHA256_NI_ROUNDS( 3, m3) SHA256_NI_MSG2(m0, m3, m2) SHA256_NI_MSG1(m2, m3)
+		SHA256_NI_ROUNDS( 4, m0) SHA256_NI_MSG2(m1, m0, m3) SHA256_NI_MSG1(m3, m0)
+		SHA256_NI_ROUNDS( 5, m1) SHA256_NI_MSG2(m2, m1, m0) SHA256_NI_MSG1(m0, m1)
+		SHA256_NI_ROUNDS( 6, m2) SHA256_NI_MSG2(m3, m2, m1) SHA256_NI_MSG1(m1, m2)
+		SHA256_NI_ROUNDS( 7, m3) SHA256_NI_MSG2(m0, m3, m2) SHA256_NI_MSG1(m2, m3)
+		SHA256_NI_ROUNDS( 8, m0) SHA256_NI_MSG2(m1, m0, m3) SHA256_NI_MSG1(m3, m0)
+		SHA256_NI_ROUNDS( 9, m1) SHA256_NI_MSG2(m2, m1, m0) SHA256_NI_MSG1(m0, m1)
+		SHA256_NI_ROUNDS(10, m2) SHA256_NI_MSG2(m3, m2, m1) SHA256_NI_MSG1(m1, m2)
+		SHA256_NI_ROUNDS(11, m3) SHA256_NI_MSG2(m0, m3, m2) SHA256_NI_MSG1(m2, m3)
+		SHA256_NI_ROUNDS(12, m0) SHA256_NI_MSG2(m1, m0, m3) SHA256_NI_MSG1(m3, m0)
+		SHA256_NI_ROUNDS(13, m1) SHA256_NI_MSG2(m2, m1, m0)
+		SHA256_NI_ROUNDS(14, m2) SHA256_NI_MSG2(m3, m2, m1)
+		SHA256_NI_ROUNDS(15, m3)
+
+		abef = _mm_add_epi32(abef, abef_save);
+		cdgh = _mm_add_epi32(cdgh, cdgh_save);
+	}
+
+	tmp  = _mm_shuffle_epi32(abef, 0x1B);	// FEBA
+	cdgh = _mm_shuffle_epi32(cdgh, 0xB1);	// DCHG
+	_mm_storeu_si128((__m128i*)&state[0], _mm_blend_epi16(tmp, cdgh, 0xF0));	// DCBA
+	_mm_storeu_si128((__m128i*)&state[4], _mm_alignr_epi8(cdgh, tmp, 8));		// HGFE
+}
+#endif
+
+
+/***********************************************************************
+**
+*/	static void SHA256_Process(SHA256_CTX *ctx, REBYTE *data, REBCNT len)
+/*
+***********************************************************************/
+{
+#ifdef HAS_CPU_FEATURES
+	if (CPU_Features() & CPU_SHA) {
+		SHA256_Blocks_NI(ctx->state, data, len);
+		return;
+	}
+#endif
+	SHA256_Blocks(ctx->state, data, len);
+}
+
+
+/***********************************************************************
+**
+*/	void SHA256_Init(void *c)
+/*
+***********************************************************************/
+{
+	SHA256_CTX *ctx = c;
+
+	ctx->state[0] = 0x6a09e667;
+	ctx->state[1] = 0xbb67ae85;
+	ctx->state[2] = 0x3c6ef372;
+	ctx->state[3] = 0xa54ff53a;
+	ctx->state[4] = 0x510e527f;
+	ctx->state[5] = 0x9b05688c;
+	ctx->state[6] = 0x1f83d9ab;
+	ctx->state[7] = 0x5be0cd19;
+	ctx->bits = 0;
+	ctx->num = 0;
+}
+
+
+/***********************************************************************
+**
+*/	void SHA256_Update(void *c, REBYTE *data, REBCNT len)
+/*
+***********************************************************************/
+{
+	SHA256_CTX *ctx = c;
+	REBCNT n;
+
+	ctx->bits += (REBU64)len << 3;
+
+	// Fill a partial block first:
+	if (ctx->num) {
+		n = MIN(len, SHA256_BLOCK - ctx->num);
+		memcpy(ctx->block + ctx->num, data, n);
+		ctx->num += n;
+		data += n;
+		len -= n;
+		if (ctx->num < SHA256_BLOCK) return;
+		SHA256_Process(ctx, ctx->block, SHA256_BLOCK);
+		ctx->num = 0;
+	}
+
+	// Whole blocks directly from the data:
+	n = len & ~(SHA256_BLOCK - 1);
+	if (n) SHA256_Process(ctx, data, n);
+
+	ctx->num = len - n;
+	memcpy(ctx->block, data + n, ctx->num);
+}
+
+
+/***********************************************************************
+**
+*/	void SHA256_Final(REBYTE *md, void *c)
+/*
+***********************************************************************/
+{
+	SHA256_CTX *ctx = c;
+	REBU64 bits = ctx->bits;
+	REBCNT n = ctx->num;
+	REBCNT i;
+
+	ctx->block[n++] = 0x80;
+	if (n > SHA256_BLOCK - 8) {
+		CLEAR(ctx->block + n, SHA256_BLOCK - n);
+		SHA256_Process(ctx, ctx->block, SHA256_BLOCK);
+		n = 0;
+	}
+	CLEAR(ctx->block + n, SHA256_BLOCK - 8 - n);
+	for (i = 0; i < 8; i++) ctx->block[SHA256_BLOCK - 1 - i] = (REBYTE)(bits >> (i * 8));
+	SHA256_Process(ctx, ctx->block, SHA256_BLOCK);
+
+	for (i = 0; i < 8; i++) {
+		md[i*4+0] = (REBYTE)(ctx->state[i] >> 24);
+		md[i*4+1] = (REBYTE)(ctx->state[i] >> 16);
+		md[i*4+2] = (REBYTE)(ctx->state[i] >> 8);
+		md[i*4+3] = (REBYTE)(ctx->state[i]);
+	}
+
+	CLEARS(ctx);
+}
+
+
+/***********************************************************************
+**
+*/	int SHA256_CtxSize(void)
+/*
+***********************************************************************/
+{
+	return sizeof(SHA256_CTX);
+}
+
+
+/***********************************************************************
+**
+*/	REBYTE *SHA256(REBYTE *d, REBCNT n, REBYTE *md)
+/*
+**		Hash n bytes into md (32 bytes, or a static buffer if zero).
+**
+***********************************************************************/
+{
+	SHA256_CTX ctx;
+	static REBYTE m[SHA256_DIGEST];
+
+	if (md == 0) md = m;
+	SHA256_Init(&ctx);
+	SHA256_Update(&ctx, d, n);
+	SHA256_Final(md, &ctx);
+	return md;
+}
@@ -1,6 +1,13 @@
 #include "sys-zlib.h"
+#include "reb-config.h"
 #include <stdlib.h>
 
+#ifdef HAS_CPU_FEATURES
+#include <immintrin.h>
+extern unsigned int CPU_Features(void);
+#define CPU_SSSE3 8 /* as in sys-core.h */
+#endif
+
 #define BASE 65521L /* largest prime smaller than 65536 */
 #define NMAX 5552
 /* NMAX is the largest n such that 255n(n+1)/2 + (n+1)(BASE-1) <= 2^32-1 */
@@ -16,17 +23,84 @@
  * For conditions of distribution and use, see copyright notice in zlib.h 
  */
 
+#ifdef HAS_CPU_FEATURES
+/* ===========================================================================
+ * Sum 32 byte blocks sixteen lanes at a time: s1 with a sum of absolute
+ * differences against zero, s2 with byte weights 32..1 (the position of
+ * each byte from the end of its block) plus 32 times the running s1 of
+ * the blocks before it. Returns the number of bytes consumed.
+ */
+local uInt adler32_ssse3 OF((uLong *adler, const Bytef *buf, uInt len))
+    __attribute__((target("ssse3")));
+
+local uInt adler32_ssse3(adler, buf, len)
+    uLong *adler;
+    const Bytef *buf;
+    uInt len;
+{
+    const __m128i tap1 = _mm_setr_epi8(32,31,30,29,28,27,26,25,24,23,22,21,20,19,18,17);
+    const __m128i tap2 = _mm_setr_epi8(16,15,14,13,12,11,10, 9, 8, 7, 6, 5, 4, 3, 2, 1);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i ones = _mm_set1_epi16(1);
+    unsigned int s1 = *adler & 0xffff;
+    unsigned int s2 = (*adler >> 16) & 0xffff;
+    uInt blocks = len / 32;
+    uInt done = blocks * 32;
+
+    while (blocks) {
+        uInt n = blocks < NMAX / 32 ? blocks : NMAX / 32;
+        __m128i v_ps = _mm_set_epi32(0, 0, 0, s1 * n);
+        __m128i v_s2 = _mm_set_epi32(0, 0, 0, s2);
+        __m128i v_s1 = _mm_setzero_si128();
+
+        blocks -= n;
+        do {
+            __m128i bytes1 = _mm_loadu_si128((const __m128i *)buf);
+            __m128i bytes2 = _mm_loadu_si128((const __m128i *)(buf + 16));
+            v_ps = _mm_add_epi32(v_ps, v_s1);
+            v_s1 = _mm_add_epi32(v_s1, _mm_sad_epu8(bytes1, zero));
+            v_s2 = _mm_add_epi32(v_s2, _mm_madd_epi16(_mm_maddubs_epi16(bytes1, tap1), ones));
+            v_s1 = _mm_add_epi32(v_s1, _mm_sad_epu8(bytes2, zero));
+            v_s2 = _mm_add_epi32(v_s2, _mm_madd_epi16(_mm_maddubs_epi16(bytes2, tap2), ones));
+            buf += 32;
+        } while (--n);
+        v_s2 = _mm_add_epi32(v_s2, _mm_slli_epi32(v_ps, 5));
+
+        v_s1 = _mm_add_epi32(v_s1, _mm_shuffle_epi32(v_s1, _MM_SHUFFLE(2,3,0,1)));
+        v_s1 = _mm_add_epi32(v_s1, _mm_shuffle_epi32(v_s1, _MM_SHUFFLE(1,0,3,2)));
+        s1 += (unsigned int)_mm_cvtsi128_si32(v_s1);
+        v_s2 = _mm_add_epi32(v_s2, _mm_shuffle_epi32(v_s2, _MM_SHUFFLE(2,3,0,1)));
+        v_s2 = _mm_add_epi32(v_s2, _mm_shuffle_epi32(v_s2, _MM_SHUFFLE(1,0,3,2)));
+        s2 = (unsigned int)_mm_cvtsi128_si32(v_s2);
+        s1 %= BASE;
+        s2 %= BASE;
+    }
+    *adler = ((uLong)s2 << 16) | s1;
+    return done;
+}
+#endif
+
 uLong ZEXPORT adler32(adler, buf, len)
     uLong adler;
     const Bytef *buf;
     uInt len;
 {
-    unsigned long s1 = adler & 0xffff;
-    unsigned long s2 = (adler >> 16) & 0xffff;
+    unsigned long s1;
+    unsigned long s2;
     int k;
 
     if (buf == Z_NULL) return 1L;
 
+#ifdef HAS_CPU_FEATURES
+    if (len >= 64 && (CPU_Features() & CPU_SSSE3)) {
+        k = adler32_ssse3(&adler, buf, len);
+        buf += k;
+        len -= k;
+    }
+#endif
+    s1 = adler & 0xffff;
+    s2 = (adler >> 16) & 0xffff;
+
     while (len > 0) {
         k = len < NMAX ? (int)len : NMAX;
         len -= k;
@@ -54,6 +128,17 @@ uLong ZEXPORT adler32(adler, buf, len)
 	return adler32(1L, buf, len);
 }
 
+/***********************************************************************
+**
+*/	unsigned long Update_ADLER32(unsigned long adler, const char *buf, unsigned int len)
+/*
+**		Continue an ADLER32 checksum (start with 1).
+**
+***********************************************************************/
+{
+	return adler32(adler, buf, len);
+}
+
 uLong crc32(uLong num, const Bytef *buf, uInt len)
 {
 #ifndef CRC_DEFINED
@@ -139,7 +224,7 @@ typedef block_state (*compress_func) OF((deflate_state *s, int flush));
 
 local void fill_window    OF((deflate_state *s));
 local block_state deflate_stored OF((deflate_state *s, int flush));
-/* local block_state deflate_fast   OF((deflate_state *s, int flush)); */
+local block_state deflate_fast   OF((deflate_state *s, int flush));
 local block_state deflate_slow   OF((deflate_state *s, int flush));
 local void lm_init        OF((deflate_state *s));
 local void putShortMSB    OF((deflate_state *s, uInt b));
@@ -190,9 +275,9 @@ typedef struct config_s {
 local const config configuration_table[10] = {
 /*      good lazy nice chain */
 /* 0 */ {0,    0,  0,    0, deflate_stored},  /* store only */
-/* 1 */ {4,    4,  8,    4, deflate_slow}, /* maximum speed, no lazy matches */
-/* 2 */ {4,    5, 16,    8, deflate_slow},
-/* 3 */ {4,    6, 32,   32, deflate_slow},
+/* 1 */ {4,    4,  8,    4, deflate_fast}, /* maximum speed, no lazy matches */
+/* 2 */ {4,    5, 16,    8, deflate_fast},
+/* 3 */ {4,    6, 32,   32, deflate_fast},
 
 /* 4 */ {4,    4, 16,   16, deflate_slow},  /* lazy matches */
 /* 5 */ {8,   16, 32,   32, deflate_slow},
@@ -352,6 +437,51 @@ int ZEXPORT deflateInit2_(strm, level, method, windowBits, memLevel, strategy,
 }
 
 
+/* ========================================================================= */
+int ZEXPORT deflateSetDictionary (strm, dictionary, dictLength)
+    z_streamp strm;
+    const Bytef *dictionary;
+    uInt  dictLength;
+{
+    deflate_state *s;
+    uInt length = dictLength;
+    uInt n;
+    IPos hash_head = 0;
+
+    if (strm == Z_NULL || strm->state == Z_NULL || dictionary == Z_NULL)
+        return Z_STREAM_ERROR;
+
+    s = strm->state;
+    /* Raw (noheader) streams start out busy, so also allow them before
+     * any input, as is done to deflate blocks in parallel:
+     */
+    if (s->status != INIT_STATE && (!s->noheader || strm->total_in != 0))
+        return Z_STREAM_ERROR;
+
+    if (!s->noheader) strm->adler = adler32(strm->adler, dictionary, dictLength);
+
+    if (length < MIN_MATCH) return Z_OK;
+    if (length > MAX_DIST(s)) {
+	length = MAX_DIST(s);
+	dictionary += dictLength - length; /* use the tail of the dictionary */
+    }
+    zmemcpy(s->window, (Bytef *)dictionary, length);
+    s->strstart = length;
+    s->block_start = (long)length;
+
+    /* Insert all strings in the hash table (except for the last two bytes).
+     * s->lookahead stays null, so s->ins_h will be recomputed at the next
+     * call of fill_window.
+     */
+    s->ins_h = s->window[0];
+    UPDATE_HASH(s, s->ins_h, s->window[1]);
+    for (n = 0; n <= length - MIN_MATCH; n++) {
+	INSERT_STRING(s, n, hash_head);
+    }
+    if (hash_head) hash_head = 0;  /* to make compiler happy */
+    return Z_OK;
+}
+
 /* ========================================================================= */
 int ZEXPORT deflateReset (strm)
     z_streamp strm;
@@ -652,6 +782,52 @@ local void lm_init (s)
  * match.S. The code will be functionally equivalent.
  */
 #ifndef FASTEST
+
+/* ===========================================================================
+ * Return the number of leading bytes (0..256) that are equal in two
+ * strings, comparing a vector or machine word at a time. Only the 256
+ * bytes at scan+2..scan+257 of a match are ever read, no further than the
+ * byte loop goes, so the window needs no extra padding.
+ */
+#if defined(__SSE2__)
+#  define COMPARE_WIDE
+#  include <emmintrin.h>
+local uInt compare256(a, b)
+    const Bytef *a;
+    const Bytef *b;
+{
+    uInt n = 0;
+    int mask;
+
+    do {
+        mask = _mm_movemask_epi8(_mm_cmpeq_epi8(
+            _mm_loadu_si128((const __m128i *)(a + n)),
+            _mm_loadu_si128((const __m128i *)(b + n))));
+        if (mask != 0xffff) return n + __builtin_ctz(~mask);
+        n += 16;
+    } while (n < 256);
+    return 256;
+}
+#elif defined(__GNUC__) && defined(__BYTE_ORDER__) && \
+      __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#  define COMPARE_WIDE
+local uInt compare256(a, b)
+    const Bytef *a;
+    const Bytef *b;
+{
+    uInt n = 0;
+    unsigned long x, y;
+
+    do {
+        zmemcpy((Bytef *)&x, (Bytef *)(a + n), sizeof(x));
+        zmemcpy((Bytef *)&y, (Bytef *)(b + n), sizeof(y));
+        if (x != y) return n + (__builtin_ctzl(x ^ y) >> 3);
+        n += sizeof(x);
+    } while (n < 256);
+    return 256;
+}
+#endif
+
 local uInt longest_match(s, cur_match)
     deflate_state *s;
     IPos cur_match;                             /* current match */
@@ -678,7 +854,9 @@ local uInt longest_match(s, cur_match)
 /*     register ush scan_start = *(ushf*)scan; */
 /*     register ush scan_end   = *(ushf*)(scan+best_len-1); */
 /* #else */
+#ifndef COMPARE_WIDE
     register Bytef *strend = s->window + s->strstart + MAX_MATCH;
+#endif
     register Byte scan_end1  = scan[best_len-1];
     register Byte scan_end   = scan[best_len];
 /* #endif */
@@ -755,6 +933,10 @@ local uInt longest_match(s, cur_match)
         scan += 2, match++;
         //Assert(*scan == *match, "match[2]?");
 
+#ifdef COMPARE_WIDE
+        len = 2 + (int)compare256(scan, match);
+        scan -= 2;
+#else
         /* We check for insufficient lookahead only every 8th comparison;
          * the 256th check will be made at strstart+258.
          */
@@ -769,6 +951,7 @@ local uInt longest_match(s, cur_match)
 
         len = MAX_MATCH - (int)(strend - scan);
         scan = strend - MAX_MATCH;
+#endif
 
 #endif /* UNALIGNED_OK */
 
@@ -1033,6 +1216,98 @@ local block_state deflate_stored(s, flush)
     return flush == Z_FINISH ? finish_done : block_done;
 }
 
+/* ===========================================================================
+ * Compress as much as possible from the input stream, return the current
+ * block state.
+ * This function does not perform lazy evaluation of matches and inserts
+ * new strings in the dictionary only for unmatched strings or for short
+ * matches. It is used only for the fast compression options.
+ */
+local block_state deflate_fast(s, flush)
+    deflate_state *s;
+    int flush;
+{
+    IPos hash_head = NIL; /* head of the hash chain */
+    int bflush;           /* set if current block must be flushed */
+
+    for (;;) {
+        /* Make sure that we always have enough lookahead, except
+         * at the end of the input file. We need MAX_MATCH bytes
+         * for the next match, plus MIN_MATCH bytes to insert the
+         * string following the next match.
+         */
+        if (s->lookahead < MIN_LOOKAHEAD) {
+            fill_window(s);
+            if (s->lookahead < MIN_LOOKAHEAD && flush == Z_NO_FLUSH) {
+	        return need_more;
+	    }
+            if (s->lookahead == 0) break; /* flush the current block */
+        }
+
+        /* Insert the string window[strstart .. strstart+2] in the
+         * dictionary, and set hash_head to the head of the hash chain:
+         */
+        if (s->lookahead >= MIN_MATCH) {
+            INSERT_STRING(s, s->strstart, hash_head);
+        }
+
+        /* Find the longest match, discarding those <= prev_length.
+         * At this point we have always match_length < MIN_MATCH
+         */
+        if (hash_head != NIL && s->strstart - hash_head <= MAX_DIST(s)) {
+            /* To simplify the code, we prevent matches with the string
+             * of window index 0 (in particular we have to avoid a match
+             * of the string with itself at the start of the input file).
+             */
+            if (s->strategy != Z_HUFFMAN_ONLY) {
+                s->match_length = longest_match (s, hash_head);
+            }
+            /* longest_match() sets match_start */
+        }
+        if (s->match_length >= MIN_MATCH) {
+            check_match(s, s->strstart, s->match_start, s->match_length);
+
+            _tr_tally_dist(s, s->strstart - s->match_start,
+                           s->match_length - MIN_MATCH, bflush);
+
+            s->lookahead -= s->match_length;
+
+            /* Insert new strings in the hash table only if the match length
+             * is not too large. This saves time but degrades compression.
+             */
+            if (s->match_length <= s->max_insert_length &&
+                s->lookahead >= MIN_MATCH) {
+                s->match_length--; /* string at strstart already in hash table */
+                do {
+                    s->strstart++;
+                    INSERT_STRING(s, s->strstart, hash_head);
+                    /* strstart never exceeds WSIZE-MAX_MATCH, so there are
+                     * always MIN_MATCH bytes ahead.
+                     */
+                } while (--s->match_length != 0);
+                s->strstart++; 
+            } else {
+                s->strstart += s->match_length;
+                s->match_length = 0;
+                s->ins_h = s->window[s->strstart];
+                UPDATE_HASH(s, s->ins_h, s->window[s->strstart+1]);
+                /* If lookahead < MIN_MATCH, ins_h is garbage, but it does not
+                 * matter since it will be recomputed at next deflate call.
+                 */
+            }
+        } else {
+            /* No match, output a literal byte */
+//            Tracevv((stderr,"%c", s->window[s->strstart]));
+            _tr_tally_lit (s, s->window[s->strstart], bflush);
+            s->lookahead--;
+            s->strstart++; 
+        }
+        if (bflush) FLUSH_BLOCK(s, 0);
+    }
+    FLUSH_BLOCK(s, flush == Z_FINISH);
+    return flush == Z_FINISH ? finish_done : block_done;
+}
+
 /* ===========================================================================
  * Same as above, but achieves better compression. We use a lazy
  * evaluation for matches: a match is finally adopted only if there is
@@ -1637,6 +1912,15 @@ z_streamp z;
 }
 
 
+local int inflate_fast OF((
+    uInt,
+    uInt,
+    inflate_huft *,
+    inflate_huft *,
+    inflate_blocks_statef *,
+    z_streamp ));
+
+
 int inflate_codes(s, z, r)
 inflate_blocks_statef *s;
 z_streamp z;
@@ -1661,19 +1945,19 @@ int r;
   while (1) switch (c->mode)
   {             /* waiting for "i:"=input, "o:"=output, "x:"=nothing */
     case START:         /* x: set up for LEN */
-//#ifndef SLOW
-//      if (m >= 258 && n >= 10)
-//      {
-//        UPDATE
-//        r = inflate_fast(c->lbits, c->dbits, c->ltree, c->dtree, s, z);
-//        LOAD
-//        if (r != Z_OK)
-//        {
-//          c->mode = r == Z_STREAM_END ? WASH : BADCODE;
-//          break;
-//        }
-//      }
-//#endif /* !SLOW */
+#ifndef SLOW
+      if (m >= 258 && n >= 10)
+      {
+        UPDATE
+        r = inflate_fast(c->lbits, c->dbits, c->ltree, c->dtree, s, z);
+        LOAD
+        if (r != Z_OK)
+        {
+          c->mode = r == Z_STREAM_END ? WASH : BADCODE;
+          break;
+        }
+      }
+#endif /* !SLOW */
       c->sub.code.need = c->lbits;
       c->sub.code.tree = c->ltree;
       c->mode = LEN;
@@ -1809,6 +2093,180 @@ z_streamp z;
 }
 
 
+/* inffast.c -- process literals and length/distance pairs fast
+ * Copyright (C) 1995-1998 Mark Adler
+ * For conditions of distribution and use, see copyright notice in zlib.h 
+ */
+
+/* Refill the bit buffer with a whole little-endian word: the bytes that
+   fit are counted as consumed and k ends up with 24..31 valid bits. The
+   bits above k repeat the next input byte, so a later refill or NEEDBITS
+   ORs them in again unchanged. Needs four readable bytes at p. */
+#define RDWORD(p) ((uLong)(p)[0] | ((uLong)(p)[1] << 8) | \
+                  ((uLong)(p)[2] << 16) | ((uLong)(p)[3] << 24))
+#define REFILL {b|=RDWORD(p)<<k;p+=(31-k)>>3;n-=(31-k)>>3;k|=24;}
+#define GRABBITS(j) {if(k<(j))REFILL}
+
+/* Give back whole unused bytes (but no more than this call took), and
+   drop the look-ahead bits above k before the slow path continues. */
+#define UNGRAB {c=z->avail_in-n;c=(k>>3)<c?k>>3:c;n+=c;p-=c;k-=c<<3;b&=((uLong)1<<k)-1;}
+
+/* Called with number of bytes left to write in window at least 258
+   (the maximum string length) and number of input bytes available
+   at least ten.  The ten bytes are six bytes for the longest length/
+   distance pair plus four for the word-wide refill of the bit buffer. */
+
+local int inflate_fast(bl, bd, tl, td, s, z)
+uInt bl, bd;
+inflate_huft *tl;
+inflate_huft *td; /* need separate declaration for Borland C++ */
+inflate_blocks_statef *s;
+z_streamp z;
+{
+  inflate_huft *t;      /* temporary pointer */
+  uInt e;               /* extra bits or operation */
+  uLong b;              /* bit buffer */
+  uInt k;               /* bits in bit buffer */
+  Bytef *p;             /* input data pointer */
+  uInt n;               /* bytes available there */
+  Bytef *q;             /* output window write pointer */
+  uInt m;               /* bytes to end of window or read pointer */
+  uInt ml;              /* mask for literal/length tree */
+  uInt md;              /* mask for distance tree */
+  uInt c;               /* bytes to copy */
+  uInt d;               /* distance back to copy from */
+  Bytef *r;             /* copy source pointer */
+
+  /* load input, output, bit values */
+  LOAD
+
+  /* initialize masks */
+  ml = inflate_mask[bl];
+  md = inflate_mask[bd];
+
+  /* do until not enough input or output space for fast loop */
+  do {                          /* assume called with m >= 258 && n >= 10 */
+    /* get literal/length code */
+    GRABBITS(20)                /* max bits for literal/length code */
+    if ((e = (t = tl + ((uInt)b & ml))->exop) == 0)
+    {
+      DUMPBITS(t->INFBITS)
+//      Tracevv((stderr, t->base >= 0x20 && t->base < 0x7f ?
+//                "inflate:         * literal '%c'\n" :
+//                "inflate:         * literal 0x%02x\n", t->base));
+      *q++ = (Byte)t->base;
+      m--;
+      continue;
+    }
+    do {
+      DUMPBITS(t->INFBITS)
+      if (e & 16)
+      {
+        /* get extra bits for length */
+        e &= 15;
+        c = t->base + ((uInt)b & inflate_mask[e]);
+        DUMPBITS(e)
+//        Tracevv((stderr, "inflate:         * length %u\n", c));
+
+        /* decode distance base of block to copy */
+        GRABBITS(15);           /* max bits for distance code */
+        e = (t = td + ((uInt)b & md))->exop;
+        do {
+          DUMPBITS(t->INFBITS)
+          if (e & 16)
+          {
+            /* get extra bits to add to distance base */
+            e &= 15;
+            GRABBITS(e)         /* get extra bits (up to 13) */
+            d = t->base + ((uInt)b & inflate_mask[e]);
+            DUMPBITS(e)
+//            Tracevv((stderr, "inflate:         * distance %u\n", d));
+
+            /* do the copy */
+            m -= c;
+            if ((uInt)(q - s->window) >= d)     /* offset before dest */
+            {                                   /*  just copy */
+              r = q - d;
+              if (d >= c)                       /* no overlap */
+              {
+                zmemcpy(q, r, c);
+                q += c;
+                break;
+              }
+              *q++ = *r++;  c--;        /* minimum count is three, */
+              *q++ = *r++;  c--;        /*  so unroll loop a little */
+            }
+            else                        /* else offset after destination */
+            {
+              e = d - (uInt)(q - s->window); /* bytes from offset to end */
+              r = s->end - e;           /* pointer to offset */
+              if (c > e)                /* if source crosses, */
+              {
+                c -= e;                 /* copy to end of window */
+                do {
+                  *q++ = *r++;
+                } while (--e);
+                r = s->window;          /* copy rest from start of window */
+              }
+            }
+            do {                        /* copy all or what's left */
+              *q++ = *r++;
+            } while (--c);
+            break;
+          }
+          else if ((e & 64) == 0)
+          {
+            t += t->base;
+            e = (t += ((uInt)b & inflate_mask[e]))->exop;
+          }
+          else
+          {
+//            z->msg = (char*)"invalid distance code";
+            UNGRAB
+            UPDATE
+            return Z_DATA_ERROR;
+          }
+        } while (1);
+        break;
+      }
+      if ((e & 64) == 0)
+      {
+        t += t->base;
+        if ((e = (t += ((uInt)b & inflate_mask[e]))->exop) == 0)
+        {
+          DUMPBITS(t->INFBITS)
+//          Tracevv((stderr, t->base >= 0x20 && t->base < 0x7f ?
+//                    "inflate:         * literal '%c'\n" :
+//                    "inflate:         * literal 0x%02x\n", t->base));
+          *q++ = (Byte)t->base;
+          m--;
+          break;
+        }
+      }
+      else if (e & 32)
+      {
+//        Tracevv((stderr, "inflate:         * end of block\n"));
+        UNGRAB
+        UPDATE
+        return Z_STREAM_END;
+      }
+      else
+      {
+//        z->msg = (char*)"invalid literal/length code";
+        UNGRAB
+        UPDATE
+        return Z_DATA_ERROR;
+      }
+    } while (1);
+  } while (m >= 258 && n >= 10);
+
+  /* not enough input or output--restore pointers and return */
+  UNGRAB
+  UPDATE
+  return Z_OK;
+}
+
+
 /////////////////////////////////////////////////////////////////////////////
 
 
@@ -41,8 +41,18 @@ typedef struct reb_codec_image {
 		void *other;
 	};
 	int error;
+	// Streaming decode (CODI_DECODE_ROWS):
+	int scale;				// reduction wanted (codec may do part of it)
+	int scaled;				// reduction the codec did (w and h are after it)
+	int (*rows)(struct reb_codec_image *cdi, int y, int count, unsigned int *bits);
 } REBCDI;
 
+// CODI_DECODE_ROWS sets w and h, then passes the image to rows() in
+// top-down bands of count rows starting at row y (the bits are only
+// valid during the call). A non-zero result from rows() stops decoding.
+// A codec that cannot stream a file may instead return the whole
+// bitmap in bits as for CODI_DECODE.
+
 typedef int (*codo)(REBCDI *cdi);
 
 // Media types:
@@ -61,6 +71,7 @@ enum {
 	CODI_IDENTIFY,
 	CODI_DECODE,
 	CODI_ENCODE,
+	CODI_DECODE_ROWS,
 };
 
 // Codec errors:
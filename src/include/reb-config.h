@@ -148,21 +148,49 @@ These are now obsolete (as of A107) and should be removed:
 #ifdef TO_LINUX					// Linux/Intel
 #define ENDIAN_LITTLE
 #define HAS_LL_CONSTS
+#define HAS_EPOLL				// epoll readiness for WAIT
+#define HAS_ACCEPT4				// accept4() with SOCK_NONBLOCK
+#define HAS_SENDFILE			// sendfile() from a file to a socket
+#define HAS_DNS_THREADS			// lookups in worker threads (not blocking)
+#define HAS_IPV6				// dual-stack IPv6 sockets
+#define HAS_MMSG				// batched datagrams (recvmmsg, sendmmsg)
+#define HAS_FILE_THREADS		// async file ports use worker threads
 #endif
 
 #ifdef TO_LINUX_PPC				// Linux/PPC
 #define ENDIAN_BIG
 #define HAS_LL_CONSTS
+#define HAS_EPOLL				// epoll readiness for WAIT
+#define HAS_ACCEPT4				// accept4() with SOCK_NONBLOCK
+#define HAS_SENDFILE			// sendfile() from a file to a socket
+#define HAS_DNS_THREADS			// lookups in worker threads (not blocking)
+#define HAS_IPV6				// dual-stack IPv6 sockets
+#define HAS_MMSG				// batched datagrams (recvmmsg, sendmmsg)
+#define HAS_FILE_THREADS		// async file ports use worker threads
 #endif
 
 #ifdef TO_LINUX_ARM				// Linux/ARM
 #define ENDIAN_LITTLE
 #define HAS_LL_CONSTS
+#define HAS_EPOLL				// epoll readiness for WAIT
+#define HAS_ACCEPT4				// accept4() with SOCK_NONBLOCK
+#define HAS_SENDFILE			// sendfile() from a file to a socket
+#define HAS_DNS_THREADS			// lookups in worker threads (not blocking)
+#define HAS_IPV6				// dual-stack IPv6 sockets
+#define HAS_MMSG				// batched datagrams (recvmmsg, sendmmsg)
+#define HAS_FILE_THREADS		// async file ports use worker threads
 #endif
 
 #ifdef TO_LINUX_MIPS
 #define ENDIAN_LITTLE
 #define HAS_LL_CONSTS
+#define HAS_EPOLL				// epoll readiness for WAIT
+#define HAS_ACCEPT4				// accept4() with SOCK_NONBLOCK
+#define HAS_SENDFILE			// sendfile() from a file to a socket
+#define HAS_DNS_THREADS			// lookups in worker threads (not blocking)
+#define HAS_IPV6				// dual-stack IPv6 sockets
+#define HAS_MMSG				// batched datagrams (recvmmsg, sendmmsg)
+#define HAS_FILE_THREADS		// async file ports use worker threads
 #endif
 
 #ifdef TO_HAIKU					// same as Linux/Intel seems to work
@@ -211,11 +239,22 @@ These are now obsolete (as of A107) and should be removed:
 #undef NO_GRAPHICS
 #define ENDIAN_LITTLE
 #define HAS_LL_CONSTS
+#define HAS_EPOLL				// epoll readiness for WAIT
+#define HAS_ACCEPT4				// accept4() with SOCK_NONBLOCK
+#define HAS_SENDFILE			// sendfile() from a file to a socket
+#define HAS_DNS_THREADS			// lookups in worker threads (not blocking)
+#define HAS_IPV6				// dual-stack IPv6 sockets
+#define HAS_MMSG				// batched datagrams (recvmmsg, sendmmsg)
+#define HAS_FILE_THREADS		// async file ports use worker threads
 #endif
 
 
 //* Defaults ***********************************************************
 
+#if (__GNUC__ >= 5 || defined(__clang__)) && (defined(__i386__) || defined(__x86_64__))
+#define HAS_CPU_FEATURES		// x86 SIMD code paths chosen at runtime
+#endif
+
 #ifndef THREAD
 #define THREAD
 #endif
@@ -93,6 +93,8 @@ enum {
 	RRF_PENDING,	// Request is attached to pending list
 	RRF_ALLOC,		// Request is allocated, not a temp on stack
 	RRF_WIDE,		// Wide char IO
+	RRF_WATCH,		// Request is in the OS readiness set (no blind polling)
+	RRF_READY,		// Readiness set reported activity, retry on next poll
 };
 
 // REBOL Device Errors:
@@ -127,6 +129,7 @@ struct rebol_device {
 	REBREQ *pending;		// pending requests
 	u32 flags;				// state: open, signal
 	i32 req_size;			// size of request struct
+	u32 poll_time;			// longest msec an RDO_AUTO_POLL wait may take (0 = poll)
 };
 
 // Inializer (keep ordered same as above)
@@ -170,6 +173,9 @@ struct rebol_devreq {
 			i64  size;				// file size
 			i64  index;				// file index position
 			I64  time;				// file modification time (struct)
+			void *job;				// async read or write (RFM_ASYNC)
+			void *buffer;			// held writes (device data)
+			u32  buffer_size;		// write buffer size (0 to write through)
 		} file;
 		struct {
 			u32  local_ip;			// local address used
@@ -177,6 +183,10 @@ struct rebol_devreq {
 			u32  remote_ip;			// remote address
 			u32  remote_port;		// remote port
 			void *host_info;		// for DNS usage
+			REBYTE local_ip6[16];	// IPv6 addresses (RST_LOCAL6, RST_IPV6)
+			REBYTE remote_ip6[16];
+			int  race;				// IPv4 socket racing an IPv6 connect
+			i64  race_time;			// when the IPv6 connect began
 		} net;
 	};
 };
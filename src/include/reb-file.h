@@ -37,6 +37,7 @@ enum {
 	RFM_TRUNCATE,
 	RFM_RESEEK,			// file index has moved, reseek
 	RFM_NAME_MEM,		// converted name allocated in mem
+	RFM_ASYNC,			// read and write complete as events
 	RFM_DIR = 16,
 };
 
@@ -51,6 +52,7 @@ enum {
 	RFE_BAD_READ,		// Read failed (general)
 	RFE_BAD_WRITE,		// Write failed (general)
 	RFE_DISK_FULL,		// No space on target volume
+	RFE_BUSY,			// Async read or write still pending
 };
 
 #define MAX_FILE_NAME 1022
@@ -31,6 +31,10 @@ enum socket_types {
 	RST_UDP,					// TCP or UDP
 	RST_LISTEN = 8,				// LISTEN
 	RST_REVERSE,				// DNS reverse
+	RST_REUSE,					// LISTEN shares its port (SO_REUSEPORT)
+	RST_INET6,					// socket is IPv6 (dual-stack, IPv4 is mapped)
+	RST_IPV6,					// remote address is IPv6 (net.remote_ip6)
+	RST_LOCAL6,					// local address is IPv6 (net.local_ip6)
 };
 
 // REBOL Socket Modes (state flags)
@@ -43,6 +47,24 @@ enum {
 	RSM_SEND,					// sending
 	RSM_RECEIVE,				// receiving
 	RSM_ACCEPT,					// an inbound connection
+	RSM_VECTOR,					// send data is a REBIOV array (writev)
+	RSM_FILE,					// send data is a file request (sendfile)
 };
 
+// Scatter/gather send buffer (RSM_VECTOR):
+typedef struct rebol_io_vec {
+	REBYTE *data;
+	REBCNT len;
+} REBIOV;
+
+// UDP datagram, for batched reads and writes (RST_UDP):
+typedef struct rebol_datagram {
+	REBYTE *data;
+	REBCNT len;				// read: buffer size, then datagram size
+	u32 port;				// remote port (write: 0 is the connected peer)
+	u32 ip;					// remote address (network byte order)
+	REBINT ipv6;			// the address is ip6
+	REBYTE ip6[16];
+} REBDGM;
+
 #define IPA(a,b,c,d) (a<<24 | b<<16 | c<<8 | d)
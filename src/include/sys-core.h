@@ -46,8 +46,17 @@
 #define MAX_EXPAND_LIST 5		// number of series-1 in Prior_Expand list
 #define USE_UNICODE 1			// scanner uses unicode
 #define UNICODE_CASES 0x2E00	// size of unicode folding table
+#define UTF8_INDEX_STEP 64		// chars per UTF-8 index table entry
+#define MAX_UTF8_INDEXES 8		// UTF-8 index tables kept (see Seek_UTF8)
 #define HAS_SHA1				// allow it
 #define HAS_MD5					// allow it
+#define HAS_SHA256				// allow it
+
+// Optional CPU instructions, checked at runtime by CPU_Features():
+#define CPU_CHECKED		1		// features have been detected
+#define CPU_PCLMUL		2		// carry-less multiply (with SSE4.1)
+#define CPU_SHA			4		// SHA-1 and SHA-256 (with SSSE3 and SSE4.1)
+#define CPU_SSSE3		8		// supplemental SSE3 (used by ADLER32)
 
 // External system includes:
 #include <stdlib.h>
@@ -94,15 +103,31 @@ typedef struct rebol_port_action_map {
 } PORT_ACTION;
 
 typedef struct rebol_mold {
-	REBSER *series;		// destination series (uni)
+	REBSER *series;		// destination series (uni, or bytes for MOPT_BYTES)
 	REBCNT opts;		// special option flags
 	REBINT indent;		// indentation amount
 //	REBYTE space;		// ?
 	REBYTE period;		// for decimal point
 	REBYTE dash;		// for date fields
 	REBYTE digits;		// decimal digits
+	void (*flush)(void *out, REBYTE *data, REBCNT len); // streaming output
+	void *out;			// argument for flush (e.g. device request)
 } REB_MOLD;
 
+#define MOLD_CHUNK 0x8000	// streaming mold output chunk size
+
+//-- Checksum digest methods (see n-strings.c):
+typedef struct rebol_digest {
+	REBYTE *(*digest)(REBYTE *, REBCNT, REBYTE *);
+	void (*init)(void *);
+	void (*update)(void *, REBYTE *, REBCNT);
+	void (*final)(REBYTE *, void *);
+	int (*ctxsize)(void);
+	REBINT index;		// method symbol
+	REBINT len;			// digest size in bytes
+	REBINT hmacblock;	// block size for HMAC keys
+} REB_DIGEST;
+
 #include "reb-file.h"
 #include "reb-filereq.h"
 #include "reb-math.h"
@@ -195,6 +220,7 @@ enum REB_Mold_Opts {
 	MOPT_EMAIL,
 	MOPT_ONLY,			// Mold/only - no outer block []
 	MOPT_LINES,			// add a linefeed between each value
+	MOPT_BYTES,			// use byte buffer (widened only when needed)
 };
 
 #define GET_MOPT(v, f) GET_FLAG(v->opts, f)
@@ -347,6 +373,7 @@ enum encoding_opts {
 #define BUF_PRINT VAL_SERIES(TASK_BUF_PRINT)
 #define BUF_FORM  VAL_SERIES(TASK_BUF_FORM)
 #define BUF_MOLD  VAL_SERIES(TASK_BUF_MOLD)
+#define BUF_MOLD8 VAL_SERIES(TASK_BUF_MOLD8)
 #define BUF_UTF8  VAL_SERIES(TASK_BUF_UTF8)
 #define MOLD_LOOP VAL_SERIES(TASK_MOLD_LOOP)
 
@@ -35,6 +35,7 @@ PVAR REBYTE **PG_Boot_Strs;	// Special strings in boot.r (RS_ constants)
 PVAR REB_STATS *PG_Reb_Stats;
 PVAR REBU64 PG_Mem_Usage;	// Overall memory used
 PVAR REBU64 PG_Mem_Limit;	// Memory limit set by SECURE
+PVAR REBCNT PG_UTF8_Indexes;	// UTF-8 index tables kept (s-unicode.c)
 
 //-- Symbol Table:
 PVAR REBSER *PG_Word_Names;	// Holds all word strings. Never removed.
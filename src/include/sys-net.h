@@ -56,6 +56,7 @@ typedef long __LONG;
 #include <fcntl.h>
 #include <netdb.h>
 #include <sys/socket.h>
+#include <sys/uio.h>
 #include <netinet/in.h>
 
 #define GET_ERROR		errno
@@ -90,6 +91,17 @@ typedef struct hostent HOSTENT;
 
 typedef struct sockaddr_in SOCKAI; // Internet extensions
 
+typedef union rebol_sock_addr {	// Any socket address (IPv4 or IPv6)
+	struct sockaddr sa;
+	SOCKAI in4;
+#ifdef HAS_IPV6
+	struct sockaddr_in6 in6;
+#endif
+} SOCKAA;
+
 #define BAD_SOCKET (~0)
-#define MAX_TRANSFER 32000		// Max send/recv buffer size
+#define MAX_TRANSFER (4*1024*1024)	// Max send/recv per call (others get a turn)
+#define MAX_IOV 64				// Max buffers per writev() call
+#define MAX_MMSG 64				// Max datagrams per recvmmsg()/sendmmsg() call
 #define MAX_HOST_NAME 256		// Max length of host name
+#define RACE_MS 250				// IPv6 head start before racing IPv4 (Happy Eyeballs)
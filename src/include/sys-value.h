@@ -328,6 +328,7 @@ typedef struct Reb_Tuple {
 			REBCNT high:16;
 		} area;
 	};
+	struct rebol_view *view;	// views of its data (its own, if a view)
 #ifdef SERIES_LABELS
 	REBYTE  *label;		// identify the series
 #endif
@@ -397,7 +398,7 @@ enum {
 	SER_MARK = 1,		// Series was found during GC mark scan.
 	SER_KEEP = 1<<1,	// Series is permanent, do not GC it.
 	SER_LOCK = 1<<2,	// Series is locked, do not expand it
-	SER_EXT  = 1<<3,	// Series is external (library), do not GC it.
+	SER_EXT  = 1<<3,	// Series data is external (view or library), do not free it.
 	SER_FREE = 1<<4,	// mark series as removed
 	SER_BARE = 1<<5,	// Series has no links to GC-able values
 	SER_PROT = 1<<6,	// Series is protected from modification
@@ -408,7 +409,7 @@ enum {
 #define SERIES_CLR_FLAG(s, f) (SERIES_FLAGS(s) &= ~((f) << 8))
 #define SERIES_GET_FLAG(s, f) (SERIES_FLAGS(s) &  ((f) << 8))
 
-#define	IS_FREEABLE(s)    !SERIES_GET_FLAG(s, SER_MARK|SER_KEEP|SER_EXT|SER_FREE)
+#define	IS_FREEABLE(s)    !SERIES_GET_FLAG(s, SER_MARK|SER_KEEP|SER_FREE)
 #define MARK_SERIES(s)    SERIES_SET_FLAG(s, SER_MARK)
 #define UNMARK_SERIES(s)  SERIES_CLR_FLAG(s, SER_MARK)
 #define IS_MARK_SERIES(s) SERIES_GET_FLAG(s, SER_MARK)
@@ -657,9 +657,9 @@ extern int ZEXPORT deflateInit2 OF((z_streamp strm,
    not perform any compression: this will be done by deflate().
 */
                             
-/* extern int ZEXPORT deflateSetDictionary OF((z_streamp strm, */
-/*                                             const Bytef *dictionary, */
-/*                                             uInt  dictLength)); */
+extern int ZEXPORT deflateSetDictionary OF((z_streamp strm,
+                                             const Bytef *dictionary,
+                                             uInt  dictLength));
 /*
      Initializes the compression dictionary from the given byte sequence
    without producing any compressed output. This function must be called
@@ -21,10 +21,14 @@ decode: funct [
  	{Decodes a series of bytes into the related datatype (e.g. image!).}
 	type [word!] {Media type (jpeg, png, etc.)}
 	data [binary!] {The data to decode}
+	/scale {Reduce an image while it is decoded}
+	factor [integer!] {Divide width and height by this}
+	/part {Decode only a region of an image}
+	offset [pair!] size [pair!]
 ][
 	unless all [
 		cod: select system/codecs type
-		data: do-codec cod/entry 'decode data
+		data: apply :do-codec [cod/entry 'decode data scale factor part offset size]
 	][
 		cause-error 'access 'no-codec type
 	]
@@ -103,11 +103,14 @@ make-port*: func [
 				#"@" (emit user s1)
 			]
 
-			; optional host [:port]
+			; optional host [:port] (an IPv6 host is in brackets)
 			opt [
-				copy s1 any user-char
+				[
+					#"[" copy s1 to #"]" skip
+					| copy s1 any user-char (unless empty? s1 [attempt [s1: to tuple! s1]])
+				]
 				opt [#":" copy s2 digits (compose/into [port-id: (to integer! s2)] tail out)]
-				(unless empty? s1 [attempt [s1: to tuple! s1] emit host s1])
+				(unless empty? s1 [emit host s1])
 			]
 		]
 
@@ -221,6 +224,7 @@ init-schemes: func [
 	make-scheme [
 		title: "File Access"
 		name: 'file
+		spec: system/standard/port-spec-file
 		info: system/standard/file-info ; for C enums
 		init: func [port /local path] [
 			if url? port/spec/ref [
@@ -259,11 +263,49 @@ init-schemes: func [
 		awake: func [event] [print ['TCP-event event/type] true]
 	]
 
+	make-scheme [
+		title: "UDP Networking"
+		name: 'udp
+		spec: make system/standard/port-spec-net [port-id: none]
+		info: system/standard/net-info ; for C enums
+		; READ reuses the binaries in port/data: copy the ones to keep
+		awake: func [event] [print ['UDP-event event/type] true]
+	]
+
 	make-scheme [
 		title: "Clipboard"
 		name: 'clipboard
 	]
 
+	make-scheme [
+		title: "Checksum"
+		name: 'checksum
+		spec: system/standard/port-spec-checksum
+		init: func [port /local method] [
+			if url? port/spec/ref [
+				parse port/spec/ref [thru #":" 0 2 slash method:]
+				unless empty? method [port/spec/method: to word! to string! method]
+			]
+		]
+	]
+
+	make-scheme [
+		title: "Deflate Compression"
+		name: 'deflate
+		spec: system/standard/port-spec-zlib
+		init: func [port /local format] [
+			if url? port/spec/ref [
+				parse port/spec/ref [thru #":" 0 2 slash format:]
+				unless empty? format [port/spec/format: to word! to string! format]
+			]
+		]
+	]
+
+	make-scheme/with [
+		title: "Inflate Decompression"
+		name: 'inflate
+	] 'deflate
+
 	system/ports/system:   open [scheme: 'system]
 	system/ports/input:    open [scheme: 'console]
 	system/ports/callback: open [scheme: 'callback]
@@ -45,16 +45,372 @@
 #include "host-lib.h"
 #include "sys-net.h"
 
+#ifdef HAS_DNS_THREADS
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#endif
+#ifdef HAS_IPV6
+#include <arpa/inet.h>
+#endif
+
+#ifdef HAS_EPOLL
+#include <sys/epoll.h>
+int Watch_Socket(REBREQ *sock, int events);
+#endif
+
 extern DEVICE_CMD Init_Net(REBREQ *); // Share same init
 extern DEVICE_CMD Quit_Net(REBREQ *);
 
-extern void Signal_Device(REBREQ *req, REBINT type);
+extern int Signal_Device(REBREQ *req, REBINT type);
 
 #ifdef HAS_ASYNC_DNS
 // Async DNS requires a window handle to signal completion (WSAASync)
 extern HWND Event_Handle;
 #endif
 
+
+#ifdef HAS_DNS_THREADS
+/***********************************************************************
+**
+**	Threaded Lookups
+**
+**		Lookups are queued to a few worker threads that call the
+**		(blocking) resolver. A worker only touches its own job; the
+**		request is updated when the main thread polls (Check_DNS).
+**		Each finished job writes a byte to a pipe that the event
+**		reactor watches, so a WAIT wakes up for it.
+**
+**		Forward lookups are cached for DNS_TTL seconds. The system
+**		resolver does not report record TTLs, so one is assumed.
+**
+**		With HAS_IPV6, a lookup keeps the first IPv4 and the first
+**		IPv6 address of the host (the connect races them).
+**
+***********************************************************************/
+
+#define DNS_THREADS 4		// most worker threads
+#define DNS_CACHE 32		// cached forward lookups
+#define DNS_TTL 60			// seconds a cached lookup is kept
+
+enum {
+	DNS_QUEUED,
+	DNS_RUNNING,
+	DNS_DONE
+};
+
+typedef struct dns_job {
+	struct dns_job *next;	// work queue link
+	int state;				// DNS_QUEUED, etc.
+	int orphan;				// request closed while running (worker frees)
+	int reverse;			// address to name
+	int error;				// resolver error code
+	u32 ip;					// address (network byte order)
+	int has6;				// ip6 is valid
+	REBYTE ip6[16];			// IPv6 address
+	char name[MAX_HOST_NAME];
+} DNSJOB;
+
+typedef struct dns_cache {
+	time_t expires;
+	u32 ip;
+	int has6;
+	REBYTE ip6[16];
+	char name[MAX_HOST_NAME];
+} DNSHIT;
+
+static pthread_mutex_t DNS_Lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t DNS_Work = PTHREAD_COND_INITIALIZER;
+static DNSJOB *DNS_Queue = 0;
+static DNSJOB **DNS_Tail = &DNS_Queue;
+static int DNS_Workers = 0;	// threads started
+static int DNS_Idle = 0;	// threads waiting for work
+static int DNS_Pipe[2] = {-1, -1};
+static REBREQ DNS_Wake;		// reactor request for the pipe
+
+extern REBDEV Dev_DNS;
+static DNSHIT DNS_Hits[DNS_CACHE];
+
+
+static void Resolve_Job(DNSJOB *job)
+{
+	// Do the lookup. Runs in a worker thread.
+	struct addrinfo hints;
+	struct addrinfo *res;
+	struct addrinfo *ai;
+	SOCKAA sa;
+	int len = sizeof(sa.in4);
+	int found = 0;
+
+	if (job->reverse) {
+		CLEARS(&sa);
+		sa.in4.sin_family = AF_INET;
+		sa.in4.sin_addr.s_addr = job->ip;
+#ifdef HAS_IPV6
+		if (job->has6) {
+			sa.in6.sin6_family = AF_INET6;
+			COPY_MEM(sa.in6.sin6_addr.s6_addr, job->ip6, 16);
+			len = sizeof(sa.in6);
+		}
+#endif
+		job->error = getnameinfo(&sa.sa, len, job->name, MAX_HOST_NAME, 0, 0, NI_NAMEREQD);
+	}
+	else {
+		CLEARS(&hints);
+#ifdef HAS_IPV6
+		hints.ai_family = AF_UNSPEC;
+#else
+		hints.ai_family = AF_INET;	// (REBREQ holds IPv4 addresses)
+#endif
+		hints.ai_socktype = SOCK_STREAM;
+		job->error = getaddrinfo(job->name, 0, &hints, &res);
+		if (!job->error) {
+			for (ai = res; ai; ai = ai->ai_next) {
+				if (ai->ai_family == AF_INET && !(found & 1)) {
+					job->ip = ((SOCKAI*)ai->ai_addr)->sin_addr.s_addr;
+					found |= 1;
+				}
+#ifdef HAS_IPV6
+				else if (ai->ai_family == AF_INET6 && !(found & 2)) {
+					COPY_MEM(job->ip6, ((struct sockaddr_in6*)ai->ai_addr)->sin6_addr.s6_addr, 16);
+					job->has6 = TRUE;
+					found |= 2;
+				}
+#endif
+			}
+			freeaddrinfo(res);
+		}
+	}
+}
+
+
+static void *DNS_Worker(void *arg)
+{
+	DNSJOB *job;
+
+	pthread_mutex_lock(&DNS_Lock);
+	for (;;) {
+		while (!(job = DNS_Queue)) {
+			DNS_Idle++;
+			pthread_cond_wait(&DNS_Work, &DNS_Lock);
+			DNS_Idle--;
+		}
+		if (!(DNS_Queue = job->next)) DNS_Tail = &DNS_Queue;
+		job->state = DNS_RUNNING;
+		pthread_mutex_unlock(&DNS_Lock);
+
+		Resolve_Job(job);
+
+		pthread_mutex_lock(&DNS_Lock);
+		if (job->orphan) free(job);
+		else {
+			job->state = DNS_DONE;
+			if (write(DNS_Pipe[1], "", 1) < 0) {} // full pipe is ok
+		}
+	}
+	return 0;
+}
+
+
+static int Start_Workers(void)
+{
+	// Setup the wakeup pipe and start a worker if none is idle.
+	// Called with the lock held. Returns FALSE on failure.
+	pthread_t thread;
+	int n;
+
+	if (DNS_Pipe[0] < 0) {
+		if (pipe(DNS_Pipe)) return FALSE;
+		for (n = 0; n < 2; n++) {
+			fcntl(DNS_Pipe[n], F_SETFL, O_NONBLOCK);
+			fcntl(DNS_Pipe[n], F_SETFD, FD_CLOEXEC);
+		}
+#ifdef HAS_EPOLL
+		DNS_Wake.device = RDI_DNS;
+		DNS_Wake.socket = DNS_Pipe[0];
+		Watch_Socket(&DNS_Wake, EPOLLIN);
+#endif
+	}
+
+	if (DNS_Idle == 0 && DNS_Workers < DNS_THREADS) {
+		if (pthread_create(&thread, 0, DNS_Worker, 0)) return DNS_Workers > 0;
+		pthread_detach(thread);
+		DNS_Workers++;
+	}
+	return TRUE;
+}
+
+
+static void Drain_DNS(void)
+{
+	// Empty the wakeup pipe (one byte per finished job), so the
+	// reactor does not keep reporting it.
+	char drain[64];
+
+	if (DNS_Pipe[0] >= 0) while (read(DNS_Pipe[0], drain, sizeof(drain)) > 0);
+	CLR_FLAG(DNS_Wake.flags, RRF_READY);
+}
+
+
+/***********************************************************************
+**
+*/	int Start_DNS(REBREQ *sock)
+/*
+**		Begin a lookup of the sock->data host name, or of the
+**		sock->net.remote_ip address for RST_REVERSE. The job is
+**		held in sock->net.host_info until Free_DNS.
+**
+**		Returns DR_PEND (use Check_DNS) or DR_ERROR.
+**
+***********************************************************************/
+{
+	DNSJOB *job;
+	DNSHIT *hit;
+	time_t now = time(0);
+
+	job = malloc(sizeof(DNSJOB));
+	if (!job) return DR_ERROR;
+	CLEARS(job);
+	sock->net.host_info = job;
+
+	if (GET_FLAG(sock->modes, RST_REVERSE)) {
+		job->reverse = TRUE;
+		job->ip = sock->net.remote_ip;
+#ifdef HAS_IPV6
+		if (GET_FLAG(sock->modes, RST_IPV6)) {
+			COPY_MEM(job->ip6, sock->net.remote_ip6, 16);
+			job->has6 = TRUE;
+		}
+#endif
+	}
+	else {
+		strncpy(job->name, sock->data, MAX_HOST_NAME - 1);
+
+		// Answer from the cache, if still fresh:
+		for (hit = DNS_Hits; hit < DNS_Hits + DNS_CACHE; hit++) {
+			if (hit->expires > now && !strcmp(hit->name, job->name)) {
+				job->ip = hit->ip;
+				job->has6 = hit->has6;
+				COPY_MEM(job->ip6, hit->ip6, 16);
+				job->state = DNS_DONE;
+				return DR_PEND;
+			}
+		}
+	}
+
+	pthread_mutex_lock(&DNS_Lock);
+	if (!Start_Workers()) {
+		pthread_mutex_unlock(&DNS_Lock);
+		sock->net.host_info = 0;
+		free(job);
+		return DR_ERROR;
+	}
+	*DNS_Tail = job;
+	DNS_Tail = &job->next;
+	pthread_cond_signal(&DNS_Work);
+	pthread_mutex_unlock(&DNS_Lock);
+
+	return DR_PEND;
+}
+
+
+/***********************************************************************
+**
+*/	int Check_DNS(REBREQ *sock)
+/*
+**		Check a lookup begun by Start_DNS. When done, the address
+**		(or for RST_REVERSE, the name in sock->data) is stored in
+**		the request. The job stays allocated for the name.
+**		An IPv6 address also sets RST_IPV6 (remote_ip may then be
+**		zero, when the host has no IPv4 address).
+**
+**		Returns DR_PEND, DR_DONE, or DR_ERROR (sock->error set).
+**
+***********************************************************************/
+{
+	DNSJOB *job = (DNSJOB*)sock->net.host_info;
+	DNSHIT *hit;
+	DNSHIT *old;
+	int state;
+
+	if (!job) return DR_ERROR;
+
+	// Lookups made for TCP opens are not on the DNS device, so the
+	// pipe is emptied here too. While DNS requests are pending,
+	// Poll_DNS does it (so none of their wakeups are lost):
+	if (!Dev_DNS.pending) Drain_DNS();
+
+	pthread_mutex_lock(&DNS_Lock);
+	state = job->state;
+	pthread_mutex_unlock(&DNS_Lock);
+	if (state != DNS_DONE) return DR_PEND;
+
+	if (job->error) {
+		sock->error = job->error;
+		return DR_ERROR;
+	}
+
+	if (job->reverse) {
+		sock->data = job->name;
+		return DR_DONE;
+	}
+
+	sock->net.remote_ip = job->ip;
+#ifdef HAS_IPV6
+	if (job->has6) {
+		COPY_MEM(sock->net.remote_ip6, job->ip6, 16);
+		SET_FLAG(sock->modes, RST_IPV6);
+	}
+	else CLR_FLAG(sock->modes, RST_IPV6);
+#endif
+
+	// Cache it, replacing the same name or the oldest entry:
+	old = DNS_Hits;
+	for (hit = DNS_Hits; hit < DNS_Hits + DNS_CACHE; hit++) {
+		if (!strcmp(hit->name, job->name)) {old = hit; break;}
+		if (hit->expires < old->expires) old = hit;
+	}
+	if (old->expires <= time(0) || strcmp(old->name, job->name)) {
+		strcpy(old->name, job->name);
+		old->ip = job->ip;
+		old->has6 = job->has6;
+		COPY_MEM(old->ip6, job->ip6, 16);
+		old->expires = time(0) + DNS_TTL;
+	}
+
+	return DR_DONE;
+}
+
+
+/***********************************************************************
+**
+*/	void Free_DNS(REBREQ *sock)
+/*
+**		Release the lookup job of a request. A job still being
+**		resolved is left for its worker to free.
+**
+***********************************************************************/
+{
+	DNSJOB *job = (DNSJOB*)sock->net.host_info;
+	DNSJOB **node;
+
+	sock->net.host_info = 0;
+	CLR_FLAG(sock->flags, RRF_WATCH);
+	if (!job) return;
+
+	pthread_mutex_lock(&DNS_Lock);
+	if (job->state == DNS_RUNNING) job->orphan = TRUE;
+	else {
+		if (job->state == DNS_QUEUED) {
+			for (node = &DNS_Queue; *node != job; node = &(*node)->next);
+			if (!(*node = job->next)) DNS_Tail = node;
+		}
+		free(job);
+	}
+	pthread_mutex_unlock(&DNS_Lock);
+}
+#endif // HAS_DNS_THREADS
+
 /***********************************************************************
 **
 */	DEVICE_CMD Open_DNS(REBREQ *sock)
@@ -81,8 +437,12 @@ extern HWND Event_Handle;
 		if (sock->handle) WSACancelAsyncRequest(sock->handle);
 	}
 #endif
+#ifdef HAS_DNS_THREADS
+	Free_DNS(sock);
+#else
 	if (sock->net.host_info) OS_Free(sock->net.host_info);
 	sock->net.host_info = 0;
+#endif
 	sock->handle = 0;
 	SET_CLOSED(sock);
 	return DR_DONE; // Removes it from device's pending list (if needed)
@@ -105,6 +465,36 @@ extern HWND Event_Handle;
 	HOSTENT *he;
 #endif
 
+#ifdef HAS_DNS_THREADS
+	// Queue it for a worker thread; Poll_DNS finishes it:
+	Free_DNS(sock); // (if read again)
+
+#ifdef HAS_IPV6
+	// An IPv6 address (given as a string) is looked up in reverse:
+	if (!GET_FLAG(sock->modes, RST_REVERSE) && strchr(sock->data, ':')
+		&& inet_pton(AF_INET6, sock->data, sock->net.remote_ip6) == 1) {
+		SET_FLAG(sock->modes, RST_REVERSE);
+		SET_FLAG(sock->modes, RST_IPV6);
+	}
+#endif
+	if (Start_DNS(sock) == DR_ERROR) {
+		sock->error = GET_ERROR;
+		return DR_ERROR;
+	}
+
+	// A cached answer is done now:
+	if (Check_DNS(sock) == DR_DONE) {
+		SET_FLAG(sock->flags, RRF_DONE);
+		return DR_DONE;
+	}
+
+#ifdef HAS_EPOLL
+	// The reactor wakes WAIT when a worker is done:
+	if (GET_FLAG(DNS_Wake.flags, RRF_WATCH)) SET_FLAG(sock->flags, RRF_WATCH);
+#endif
+	return DR_PEND;
+#else
+
 	host = OS_Make(MAXGETHOSTSTRUCT); // be sure to free it
 
 #ifdef HAS_ASYNC_DNS
@@ -146,6 +536,7 @@ extern HWND Event_Handle;
 	sock->error = GET_ERROR;
 	//Signal_Device(sock, EVT_ERROR);
 	return DR_ERROR; // Remove it from pending list
+#endif
 }
 
 
@@ -154,7 +545,8 @@ extern HWND Event_Handle;
 */	DEVICE_CMD Poll_DNS(REBREQ *dr)
 /*
 **		Check for completed DNS requests. These are marked with
-**		RRF_DONE by the windows message event handler (dev-event.c).
+**		RRF_DONE by the windows message event handler (dev-event.c),
+**		or finished by a worker thread (HAS_DNS_THREADS).
 **		Completed requests are removed from the pending queue and
 **		event is signalled (for awake dispatch).
 **
@@ -165,6 +557,26 @@ extern HWND Event_Handle;
 	REBREQ *req;
 	REBOOL change = FALSE;
 	HOSTENT *host;
+#ifdef HAS_DNS_THREADS
+	int result;
+
+	Drain_DNS();
+
+	for (req = *prior; req; req = *prior) {
+		result = Check_DNS(req);
+		if (result == DR_PEND) {
+			prior = &req->next;
+			continue;
+		}
+		*prior = req->next;
+		req->next = 0;
+		CLR_FLAG(req->flags, RRF_PENDING);
+		CLR_FLAG(req->flags, RRF_WATCH);
+		SET_FLAG(req->flags, RRF_DONE);
+		Signal_Device(req, result == DR_DONE ? EVT_READ : EVT_ERROR);
+		change = TRUE;
+	}
+#else
 
 	// Scan the pending request list:
 	for (req = *prior; req; req = *prior) {
@@ -189,6 +601,7 @@ extern HWND Event_Handle;
 		}
 		else prior = &req->next;
 	}
+#endif
 
 	return change;
 }
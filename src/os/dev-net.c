@@ -35,6 +35,10 @@
 **
 ***********************************************************************/
 
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE		// accept4()
+#endif
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -43,6 +47,15 @@
 #include "host-lib.h"
 #include "sys-net.h"
 
+#ifdef HAS_EPOLL
+#include <sys/epoll.h>
+#endif
+#ifdef HAS_SENDFILE
+#include <sys/sendfile.h>
+#endif
+
+#define MAX_ACCEPTS 32	// connections taken per accept wakeup (if events fit)
+
 #if (0)
 #define WATCH1(s,a) printf(s, a)
 #define WATCH2(s,a,b) printf(s, a, b)
@@ -53,8 +66,16 @@
 #define WATCH4(s,a,b,c,d)
 #endif
 
-void Signal_Device(REBREQ *req, REBINT type);
+int Signal_Device(REBREQ *req, REBINT type);
 DEVICE_CMD Listen_Socket(REBREQ *sock);
+#ifdef HAS_EPOLL
+int Watch_Socket(REBREQ *sock, int events);
+#endif
+#ifdef HAS_DNS_THREADS
+int Start_DNS(REBREQ *sock);
+int Check_DNS(REBREQ *sock);
+void Free_DNS(REBREQ *sock);
+#endif
 
 #ifdef TO_WIN32
 extern HWND Event_Handle; // For WSAAsync API
@@ -75,16 +96,76 @@ static void Set_Addr(SOCKAI *sa, long ip, int port)
 	sa->sin_port = htons((unsigned short)port);
 }
 
+static int Make_Addr(SOCKAA *sa, REBREQ *sock, long ip, REBYTE *ip6, int port)
+{
+	// Set a socket address for the socket's family. Returns its size.
+	// An IPv6 socket reaches an IPv4 address as ::ffff:a.b.c.d, and
+	// a zero address (INADDR_ANY) as ::.
+	CLEARS(sa);
+#ifdef HAS_IPV6
+	if (GET_FLAG(sock->modes, RST_INET6)) {
+		sa->in6.sin6_family = AF_INET6;
+		sa->in6.sin6_port = htons((unsigned short)port);
+		if (ip6) COPY_MEM(sa->in6.sin6_addr.s6_addr, ip6, 16);
+		else if (ip) {
+			sa->in6.sin6_addr.s6_addr[10] = 0xff;
+			sa->in6.sin6_addr.s6_addr[11] = 0xff;
+			COPY_MEM(sa->in6.sin6_addr.s6_addr + 12, &ip, 4);
+		}
+		return sizeof(sa->in6);
+	}
+#endif
+	Set_Addr(&sa->in4, ip, port);
+	return sizeof(sa->in4);
+}
+
+static REBOOL Addr_IP(SOCKAA *sa, u32 *ip, REBYTE *ip6, u32 *port)
+{
+	// Get the address and port of a socket address. Returns TRUE
+	// for an IPv6 address (stored in ip6), else it is in ip.
+	// Mapped IPv4 addresses are returned as IPv4, and so is the
+	// any address (::) of a dual-stack socket (as 0.0.0.0).
+	*ip = 0;
+#ifdef HAS_IPV6
+	if (sa->sa.sa_family == AF_INET6) {
+		*port = ntohs(sa->in6.sin6_port);
+		if (IN6_IS_ADDR_UNSPECIFIED(&sa->in6.sin6_addr)) return FALSE;
+		if (!IN6_IS_ADDR_V4MAPPED(&sa->in6.sin6_addr)) {
+			COPY_MEM(ip6, sa->in6.sin6_addr.s6_addr, 16);
+			return TRUE;
+		}
+		COPY_MEM((char*)ip, sa->in6.sin6_addr.s6_addr + 12, 4);
+		return FALSE;
+	}
+#endif
+	*ip = sa->in4.sin_addr.s_addr; //htonl(ip); NOTE: REBOL stays in network byte order
+	*port = ntohs(sa->in4.sin_port);
+	return FALSE;
+}
+
+static void Get_Addr(SOCKAA *sa, REBREQ *sock, REBOOL remote)
+{
+	// Store a local or remote socket address in the request.
+	// Sets its flag (RST_IPV6 or RST_LOCAL6) for an IPv6 address,
+	// clears it for IPv4.
+	int flag = remote ? RST_IPV6 : RST_LOCAL6;
+	REBOOL ipv6 = remote
+		? Addr_IP(sa, &sock->net.remote_ip, sock->net.remote_ip6, &sock->net.remote_port)
+		: Addr_IP(sa, &sock->net.local_ip, sock->net.local_ip6, &sock->net.local_port);
+
+	if (ipv6) SET_FLAG(sock->modes, flag);
+	else CLR_FLAG(sock->modes, flag);
+}
+
 static void Get_Local_IP(REBREQ *sock)
 {
 	// Get the local IP address and port number.
 	// This code should be fast and never fail.
-	SOCKAI sa;
+	SOCKAA sa;
 	int len = sizeof(sa);
 
-	getsockname(sock->socket, (struct sockaddr *)&sa, &len);
-	sock->net.local_ip = sa.sin_addr.s_addr; //htonl(ip); NOTE: REBOL stays in network byte order
-	sock->net.local_port = ntohs(sa.sin_port);
+	getsockname(sock->socket, &sa.sa, &len);
+	Get_Addr(&sa, sock, FALSE);
 }
 
 static REBOOL Nonblocking_Mode(SOCKET sock)
@@ -104,6 +185,105 @@ static REBOOL Nonblocking_Mode(SOCKET sock)
 }
 
 
+static long Send_Vector(REBREQ *sock, long len)
+{
+	// Send the unsent part of a REBIOV array with one call.
+	REBIOV *vec = (REBIOV*)sock->data;
+	REBCNT skip = sock->actual;
+#ifdef TO_WIN32
+	for (; skip >= vec->len; vec++) skip -= vec->len;
+	return send(sock->socket, vec->data + skip, MIN(len, (long)(vec->len - skip)), 0);
+#else
+	struct iovec iov[MAX_IOV];
+	int n;
+
+	for (; skip >= vec->len; vec++) skip -= vec->len;
+	for (n = 0; n < MAX_IOV && len > 0; n++, vec++) {
+		iov[n].iov_base = vec->data + skip;
+		iov[n].iov_len = MIN(len, (long)(vec->len - skip));
+		len -= iov[n].iov_len;
+		skip = 0;
+	}
+	return writev(sock->socket, iov, n);
+#endif
+}
+
+static long Transfer_Datagrams(REBREQ *sock, int mode)
+{
+	// Send or receive the next datagrams of a REBDGM array, as
+	// many as one call allows. Returns the count, or -1 (see errno).
+	REBDGM *dgm = (REBDGM*)sock->data + sock->actual;
+	int count = MIN(sock->length - sock->actual, MAX_MMSG);
+	int n;
+#ifdef HAS_MMSG
+	struct mmsghdr msg[MAX_MMSG];
+	struct iovec iov[MAX_MMSG];
+	SOCKAA addr[MAX_MMSG];
+
+	CLEAR(msg, count * sizeof(msg[0]));
+	for (n = 0; n < count; n++) {
+		iov[n].iov_base = dgm[n].data;
+		iov[n].iov_len = dgm[n].len;
+		msg[n].msg_hdr.msg_iov = &iov[n];
+		msg[n].msg_hdr.msg_iovlen = 1;
+		if (mode == RSM_RECEIVE || dgm[n].port) msg[n].msg_hdr.msg_name = &addr[n];
+		if (mode == RSM_RECEIVE) msg[n].msg_hdr.msg_namelen = sizeof(addr[n]);
+		else if (dgm[n].port) msg[n].msg_hdr.msg_namelen =
+			Make_Addr(&addr[n], sock, dgm[n].ip, dgm[n].ipv6 ? dgm[n].ip6 : 0, dgm[n].port);
+	}
+
+	if (mode == RSM_SEND) return sendmmsg(sock->socket, msg, count, 0);
+
+	count = recvmmsg(sock->socket, msg, count, 0, 0);
+	for (n = 0; n < count; n++) {
+		dgm[n].len = msg[n].msg_len;
+		dgm[n].ipv6 = Addr_IP(&addr[n], &dgm[n].ip, dgm[n].ip6, &dgm[n].port);
+	}
+	return count;
+#else
+	SOCKAA addr;
+	int len;
+	long result = 0;
+
+	for (n = 0; n < count; n++, dgm++) {
+		if (mode == RSM_RECEIVE) {
+			len = sizeof(addr);
+			result = recvfrom(sock->socket, dgm->data, dgm->len, 0, &addr.sa, &len);
+			if (result < 0) break;
+			dgm->len = result;
+			dgm->ipv6 = Addr_IP(&addr, &dgm->ip, dgm->ip6, &dgm->port);
+		}
+		else if (dgm->port) {
+			len = Make_Addr(&addr, sock, dgm->ip, dgm->ipv6 ? dgm->ip6 : 0, dgm->port);
+			result = sendto(sock->socket, dgm->data, dgm->len, 0, &addr.sa, len);
+		}
+		else result = send(sock->socket, dgm->data, dgm->len, 0);
+		if (result < 0) break;
+	}
+	return (n > 0) ? n : -1;
+#endif
+}
+
+#ifdef HAS_SENDFILE
+static long Send_File(REBREQ *sock, long len)
+{
+	// Send from a file request, without copying through user space.
+	// The file index moves, so its next read or write must reseek.
+	// The 64-bit call allows large files when off_t is 32 bits (-m32).
+	REBREQ *file = (REBREQ*)sock->data;
+	off64_t offset = file->file.index;
+	long result;
+
+	result = sendfile64(sock->socket, file->id, &offset, len);
+	if (result > 0) {
+		file->file.index = offset;
+		SET_FLAG(file->modes, RFM_RESEEK);
+	}
+	return result;
+}
+#endif
+
+
 /***********************************************************************
 **
 */	DEVICE_CMD Init_Net(REBREQ *dr)
@@ -204,6 +384,20 @@ static REBOOL Nonblocking_Mode(SOCKET sock)
 	}
 
 	// Bind to the transport service, return socket handle or error:
+	CLR_FLAG(sock->modes, RST_INET6);
+	CLR_FLAG(sock->modes, RST_IPV6);
+	CLR_FLAG(sock->modes, RST_LOCAL6);
+	sock->net.race = 0;
+#ifdef HAS_IPV6
+	// Prefer a dual-stack IPv6 socket (it also reaches IPv4 hosts):
+	result = (int)socket(AF_INET6, type, protocol);
+	if (result != BAD_SOCKET) {
+		int off = 0;
+		setsockopt(result, IPPROTO_IPV6, IPV6_V6ONLY, (char*)&off, sizeof(off));
+		SET_FLAG(sock->modes, RST_INET6);
+	}
+	else
+#endif
 	result = (int)socket(AF_INET, type, protocol);
 
 	// Failed, get error code (os local):
@@ -240,15 +434,26 @@ static REBOOL Nonblocking_Mode(SOCKET sock)
 
 	if (GET_FLAG(sock->state, RSM_OPEN)) {
 
+#ifdef HAS_EPOLL
+		Watch_Socket(sock, 0);
+#endif
 		sock->state = 0;  // clear: RSM_OPEN, RSM_CONNECT
 
+		// If an IPv4 connect was racing, drop it:
+		if (sock->net.race > 0) CLOSE_SOCKET(sock->net.race);
+		sock->net.race = 0;
+
 		// If DNS pending, abort it:
 		if (sock->net.host_info) {  // indicates DNS phase active
+#ifdef HAS_DNS_THREADS
+			Free_DNS(sock);
+#else
 #ifdef HAS_ASYNC_DNS
 			if (sock->handle) WSACancelAsyncRequest(sock->handle);
 #endif
 			OS_Free(sock->net.host_info);
 			sock->socket = sock->length; // Restore TCP socket (see Lookup)
+#endif
 		}
 
 		if (CLOSE_SOCKET(sock->socket)) {
@@ -308,6 +513,23 @@ static REBOOL Nonblocking_Mode(SOCKET sock)
 		return DR_PEND; // keep it on pending list
 	}
 	OS_Free(host);
+#elif defined(HAS_DNS_THREADS)
+	// Resolve in a DNS worker thread, polling for completion:
+	if (!sock->net.host_info && Start_DNS(sock) == DR_ERROR) {
+		sock->error = GET_ERROR;
+		return DR_ERROR;
+	}
+	switch (Check_DNS(sock)) {
+	case DR_PEND:
+		return DR_PEND;
+	case DR_DONE:
+		Free_DNS(sock);
+		CLR_FLAG(sock->flags, RRF_DONE);
+		Signal_Device(sock, EVT_LOOKUP);
+		return DR_DONE;
+	}
+	Free_DNS(sock);
+	return DR_ERROR; // (error code is set)
 #else
 	// Use old-style blocking DNS (mainly for testing purposes):
 	host = gethostbyname(sock->data);
@@ -327,6 +549,93 @@ static REBOOL Nonblocking_Mode(SOCKET sock)
 }
 
 
+#ifdef HAS_IPV6
+#define CONNECTING(r) ((r) == NE_WOULDBLOCK || (r) == NE_INPROGRESS || (r) == NE_ALREADY)
+#define SOCK_TYPE(s) (GET_FLAG((s)->modes, RST_UDP) ? SOCK_DGRAM : SOCK_STREAM)
+
+/***********************************************************************
+**
+*/	static REBOOL Racing(REBREQ *sock)
+/*
+**		True when an IPv6 connect may still race an IPv4 one:
+**		the host has both addresses and the race is not decided.
+**
+***********************************************************************/
+{
+	return GET_FLAG(sock->modes, RST_INET6) && GET_FLAG(sock->modes, RST_IPV6)
+		&& sock->net.remote_ip && sock->net.race >= 0;
+}
+
+
+/***********************************************************************
+**
+*/	static int Race_IPv4(REBREQ *sock, int result)
+/*
+**		Happy Eyeballs (RFC 8305). Given the status of the IPv6
+**		connect, start an IPv4 connect when IPv6 fails, or when it is
+**		still pending after RACE_MS. Both then run until one connects;
+**		the winner becomes the request's socket. Returns the status
+**		to use for the connect.
+**
+***********************************************************************/
+{
+	SOCKAA sa;
+	int len;
+	int race;
+
+	if (result == 0 || result == NE_ISCONN) goto drop; // IPv6 won
+
+	// IPv6 failed: fall back to IPv4 on a fresh socket:
+	if (!CONNECTING(result)) {
+		if (sock->net.race <= 0) {
+			race = (int)socket(AF_INET6, SOCK_TYPE(sock), 0);
+			if (race == BAD_SOCKET) goto drop;
+			Nonblocking_Mode(race);
+			sock->net.race = race;
+		}
+#ifdef HAS_EPOLL
+		Watch_Socket(sock, 0);
+#endif
+		CLOSE_SOCKET(sock->socket);
+		sock->socket = sock->net.race;
+		sock->net.race = -1;
+		CLR_FLAG(sock->modes, RST_IPV6);
+		len = Make_Addr(&sa, sock, sock->net.remote_ip, 0, sock->net.remote_port);
+		return connect(sock->socket, &sa.sa, len) ? GET_ERROR : 0;
+	}
+
+	// IPv6 still pending. Give it a head start:
+	if (!sock->net.race) {
+		if (OS_Delta_Time(sock->net.race_time, 0) < RACE_MS * 1000) return result;
+		race = (int)socket(AF_INET6, SOCK_TYPE(sock), 0);
+		if (race == BAD_SOCKET) goto drop;
+		Nonblocking_Mode(race);
+		sock->net.race = race;
+	}
+
+	len = Make_Addr(&sa, sock, sock->net.remote_ip, 0, sock->net.remote_port);
+	race = connect(sock->net.race, &sa.sa, len) ? GET_ERROR : 0;
+	if (CONNECTING(race)) return result; // both still trying
+	if (race != 0 && race != NE_ISCONN) goto drop; // IPv4 failed, wait on IPv6
+
+	// IPv4 won, it replaces the IPv6 socket:
+#ifdef HAS_EPOLL
+	Watch_Socket(sock, 0);
+#endif
+	CLOSE_SOCKET(sock->socket);
+	sock->socket = sock->net.race;
+	sock->net.race = -1;
+	CLR_FLAG(sock->modes, RST_IPV6);
+	return 0;
+
+drop:
+	if (sock->net.race > 0) CLOSE_SOCKET(sock->net.race);
+	sock->net.race = -1;
+	return result;
+}
+#endif
+
+
 /***********************************************************************
 **
 */	DEVICE_CMD Connect_Socket(REBREQ *sock)
@@ -349,18 +658,30 @@ static REBOOL Nonblocking_Mode(SOCKET sock)
 ***********************************************************************/
 {
 	int result;
-	SOCKAI sa;
+	int len;
+	SOCKAA sa;
 
 	if (GET_FLAG(sock->modes, RST_LISTEN))
 		return Listen_Socket(sock);
 
 	if (GET_FLAG(sock->state, RSM_CONNECT)) return DR_DONE; // already connected
 
-	Set_Addr(&sa, sock->net.remote_ip, sock->net.remote_port);
-	result = connect(sock->socket, (struct sockaddr *)&sa, sizeof(sa));
+#ifdef HAS_IPV6
+	// An IPv4 socket (kernel without IPv6) can only use an IPv4 address:
+	if (!GET_FLAG(sock->modes, RST_INET6)) CLR_FLAG(sock->modes, RST_IPV6);
+#endif
+
+	len = Make_Addr(&sa, sock, sock->net.remote_ip,
+		GET_FLAG(sock->modes, RST_IPV6) ? sock->net.remote_ip6 : 0, sock->net.remote_port);
+	result = connect(sock->socket, &sa.sa, len);
 
 	if (result != 0) result = GET_ERROR;
 
+#ifdef HAS_IPV6
+	if (!GET_FLAG(sock->state, RSM_ATTEMPT)) sock->net.race_time = OS_Delta_Time(0, 0);
+	if (Racing(sock)) result = Race_IPv4(sock, result);
+#endif
+
 	WATCH2("connect() error: %d - %s\n", result, strerror(result));
 
 	switch (result) {
@@ -418,31 +739,62 @@ static REBOOL Nonblocking_Mode(SOCKET sock)
 **
 **		Note that the mode flag is cleared by the caller, not here.
 **
+**		A send may also take its data from an array of buffers
+**		(RSM_VECTOR) or from an open file request (RSM_FILE).
+**		For those, sock->data is left as is and sock->actual
+**		tells how much has been sent.
+**
+**		A UDP socket (RST_UDP) transfers a REBDGM array: length
+**		is the number of datagrams, actual the number done. A
+**		read takes what has arrived (up to length), a write sends
+**		them all. A bound socket needs no connect.
+**
 ***********************************************************************/
 {
-	int result;
+	long result;
 	long len;
 	int mode = (sock->command == RDC_READ ? RSM_RECEIVE : RSM_SEND);
 
-	if (!GET_FLAG(sock->state, RSM_CONNECT)) {
+	if (!GET_FLAG(sock->state, RSM_CONNECT)
+		&& !(GET_FLAG(sock->modes, RST_UDP) && GET_FLAG(sock->state, RSM_BIND))) {
 		sock->error = -18;
 		return DR_ERROR;
 	}
 
 	SET_FLAG(sock->state, mode);
 
-	// Limit size of transfer:
-	len = MIN(sock->length, MAX_TRANSFER);
+	if (GET_FLAG(sock->modes, RST_UDP)) {
+		result = (sock->actual < sock->length) ? Transfer_Datagrams(sock, mode) : 0;
+		WATCH2("datagrams: %d of %d\n", result, sock->length);
 
-	if (mode == RSM_SEND) {
-		// If host is no longer connected:
-		result = send(sock->socket, sock->data, len, 0);
+		if (result >= 0) {
+			sock->actual += result;
+			if (mode == RSM_RECEIVE || sock->actual >= sock->length) {
+				Signal_Device(sock, mode == RSM_RECEIVE ? EVT_READ : EVT_WROTE);
+				return DR_DONE;
+			}
+			return DR_PEND;
+		}
+	}
+	else if (mode == RSM_SEND) {
+		// Limit size of transfer to what is left:
+		len = MIN(sock->length - sock->actual, MAX_TRANSFER);
+
+		if (len <= 0) result = 0;
+		else if (GET_FLAG(sock->state, RSM_VECTOR)) result = Send_Vector(sock, len);
+#ifdef HAS_SENDFILE
+		else if (GET_FLAG(sock->state, RSM_FILE)) result = Send_File(sock, len);
+#endif
+		else {
+			result = send(sock->socket, sock->data, len, 0);
+			if (result > 0) sock->data += result;
+		}
 		WATCH2("send() len: %d actual: %d\n", len, result);
 
 		if (result >= 0) {
-			sock->data += result;
 			sock->actual += result;
-			if (sock->actual >= sock->length) {
+			// Done, or the file ended before the expected length:
+			if (sock->actual >= sock->length || (result == 0 && len > 0)) {
 				Signal_Device(sock, EVT_WROTE);
 				return DR_DONE;
 			}
@@ -451,6 +803,7 @@ static REBOOL Nonblocking_Mode(SOCKET sock)
 		// if (result < 0) ...
 	}
 	else {
+		len = MIN(sock->length, MAX_TRANSFER);
 		result = recv(sock->socket, sock->data, len, 0);
 		WATCH2("recv() len: %d result: %d\n", len, result);
 
@@ -497,10 +850,11 @@ static REBOOL Nonblocking_Mode(SOCKET sock)
 {
 	int result;
 	int len = 1;
-	SOCKAI sa;
+	int size;
+	SOCKAA sa;
 
 	// Setup socket address range and port:
-	Set_Addr(&sa, INADDR_ANY, sock->net.local_port);
+	size = Make_Addr(&sa, sock, INADDR_ANY, 0, sock->net.local_port);
 
 	// Allow listen socket reuse:
 	result = setsockopt(sock->socket, SOL_SOCKET, SO_REUSEADDR, (char*)(&len), sizeof(len));
@@ -510,8 +864,16 @@ lserr:
 		return DR_ERROR;
 	}
 
+#ifdef SO_REUSEPORT
+	// Let several listeners share the port (the OS spreads connections):
+	if (GET_FLAG(sock->modes, RST_REUSE)) {
+		result = setsockopt(sock->socket, SOL_SOCKET, SO_REUSEPORT, (char*)(&len), sizeof(len));
+		if (result) goto lserr;
+	}
+#endif
+
 	// Bind the socket to our local address:
-	result = bind(sock->socket, (struct sockaddr *)&sa, sizeof(sa));
+	result = bind(sock->socket, &sa.sa, size);
 	if (result) goto lserr;
 
 	SET_FLAG(sock->state, RSM_BIND);
@@ -524,6 +886,10 @@ lserr:
 	}
 
 	Get_Local_IP(sock);
+
+	// A UDP socket is ready once bound (nothing to accept):
+	if (GET_FLAG(sock->modes, RST_UDP)) return DR_DONE;
+
 	sock->command = RDC_CREATE;	// the command done on wakeup
 
 	return DR_PEND;
@@ -534,7 +900,14 @@ lserr:
 **
 */	 DEVICE_CMD Accept_Socket(REBREQ *sock)
 /*
-**		Accept an inbound connection on a TCP listen socket.
+**		Accept inbound connections on a TCP listen socket.
+**
+**		Drains up to MAX_ACCEPTS connections from the backlog on
+**		each call, so a burst is not taken one per poll cycle.
+**		Each connection needs an event, so the batch stops when
+**		the event queue is full. A connection that could not be
+**		signalled is counted in sock->actual and signalled first
+**		on the next call, before any more are accepted.
 **
 **		The function will return:
 **			=0: succeeded
@@ -548,45 +921,70 @@ lserr:
 **
 ***********************************************************************/
 {
-	SOCKAI sa;
+	SOCKAA sa;
 	REBREQ *news;
-	int len = sizeof(sa);
+	REBREQ **tail;
+	int len;
 	int result;
-	extern void Attach_Request(REBREQ **prior, REBREQ *req);
-
-	// Accept a new socket, if there is one:
-	result = accept(sock->socket, (struct sockaddr *)&sa, &len);
+	int n;
 
-	if (result == BAD_SOCKET) {
-		result = GET_ERROR;
-		if (result == NE_WOULDBLOCK) return DR_PEND;
-		sock->error = result;
-		//Signal_Device(sock, EVT_ERROR);
-		return DR_ERROR;
+	// Signal connections that were held back by a full queue:
+	for (; sock->actual > 0; sock->actual--) {
+		if (!Signal_Device(sock, EVT_ACCEPT)) return DR_PEND;
 	}
 
-	// To report the new socket, the code here creates a temporary
-	// request and copies the listen request to it. Then, it stores
-	// the new values for IP and ports and links this request to the
-	// original via the sock->data.
-	news = MAKE_NEW(*news);	// Be sure to deallocate it
-	CLEARS(news);
-//	*news = *sock;
-	news->device = sock->device;
+	// Find the end of the accept list (to queue in arrival order):
+	for (tail = (REBREQ**)&sock->data; *tail; tail = &(*tail)->next);
 
-	SET_OPEN(news);
-	SET_FLAG(news->state, RSM_OPEN);
-	SET_FLAG(news->state, RSM_CONNECT);
+	for (n = 0; n < MAX_ACCEPTS; n++) {
 
-	news->socket = result;
-	news->net.remote_ip   = sa.sin_addr.s_addr; //htonl(ip); NOTE: REBOL stays in network byte order
-	news->net.remote_port = ntohs(sa.sin_port);
-	Get_Local_IP(news);
+		// Accept a new socket, if there is one:
+		len = sizeof(sa);
+#ifdef HAS_ACCEPT4
+		result = accept4(sock->socket, &sa.sa, &len, SOCK_NONBLOCK | SOCK_CLOEXEC);
+#else
+		result = accept(sock->socket, &sa.sa, &len);
+#endif
 
-	//Nonblocking_Mode(news->socket);  ???Needed?
+		if (result == BAD_SOCKET) {
+			result = GET_ERROR;
+			if (result == NE_WOULDBLOCK || n > 0) break; // report what we have
+			sock->error = result;
+			//Signal_Device(sock, EVT_ERROR);
+			return DR_ERROR;
+		}
+
+		// To report the new socket, the code here creates a temporary
+		// request and copies the listen request to it. Then, it stores
+		// the new values for IP and ports and links this request to the
+		// original via the sock->data.
+		news = MAKE_NEW(*news);	// Be sure to deallocate it
+		CLEARS(news);
+		news->device = sock->device;
+
+		SET_OPEN(news);
+		SET_FLAG(news->flags, RRF_PENDING);
+		SET_FLAG(news->state, RSM_OPEN);
+		SET_FLAG(news->state, RSM_CONNECT);
+
+		news->socket = result;
+		news->modes = sock->modes & (1 << RST_INET6);
+		Get_Addr(&sa, news, TRUE);
+		Get_Local_IP(news);
+
+#ifndef HAS_ACCEPT4
+		// Reads and writes must pend, not block (inherited only on Win32):
+		Nonblocking_Mode(news->socket);
+#endif
 
-	Attach_Request((REBREQ**)&sock->data, news);
-	Signal_Device(sock, EVT_ACCEPT);
+		*tail = news;
+		tail = &news->next;
+
+		if (!Signal_Device(sock, EVT_ACCEPT)) {
+			sock->actual = 1; // queue is full, signal it later
+			break;
+		}
+	}
 
 	// Even though we signalled, we keep the listen pending to
 	// accept additional connections.
@@ -594,6 +992,49 @@ lserr:
 }
 
 
+#ifdef HAS_EPOLL
+/***********************************************************************
+**
+*/	static DEVICE_CMD Async_Socket(REBREQ *sock)
+/*
+**		Run a socket command that may pend, keeping the event
+**		reactor in step: a pending socket is watched for the
+**		readiness it waits on, otherwise it is unwatched.
+**		Connect and write wait to send; the others to receive.
+**
+***********************************************************************/
+{
+	int result;
+	int events = EPOLLIN;
+
+	switch (sock->command) {
+	case RDC_WRITE:
+		events = EPOLLOUT;
+		// fall through
+	case RDC_READ:
+		result = Transfer_Socket(sock);
+		break;
+	case RDC_CONNECT:
+		if (!GET_FLAG(sock->modes, RST_LISTEN)) events = EPOLLOUT;
+		result = Connect_Socket(sock);
+#ifdef HAS_IPV6
+		if (Racing(sock)) events = 0; // polled, so IPv4 can start on time
+#endif
+		break;
+	default:
+		result = Accept_Socket(sock);
+		if (sock->actual) events = 0; // polled until held accepts are signalled
+	}
+
+	Watch_Socket(sock, (result == DR_PEND) ? events : 0);
+	return result;
+}
+#define ASYNC(cmd) Async_Socket
+#else
+#define ASYNC(cmd) cmd
+#endif
+
+
 /***********************************************************************
 **
 **	Command Dispatch Table (RDC_ enum order)
@@ -605,13 +1046,13 @@ static DEVICE_CMD_FUNC Dev_Cmds[RDC_MAX] = {
 	Quit_Net,
 	Open_Socket,
 	Close_Socket,
-	Transfer_Socket,		// Read
-	Transfer_Socket,		// Write
+	ASYNC(Transfer_Socket),	// Read
+	ASYNC(Transfer_Socket),	// Write
 	0,	// poll
-	Connect_Socket,
+	ASYNC(Connect_Socket),
 	0,	// query
 	0,	// modify
-	Accept_Socket,			// Create
+	ASYNC(Accept_Socket),	// Create
 	0,	// delete
 	0,	// rename
 	Lookup_Socket
@@ -101,6 +101,15 @@ static int Poll_Default(REBDEV *dev)
 
 	for (req = *prior; req; req = *prior) {
 
+		// Requests in the OS readiness set wait until reported:
+		if (GET_FLAG(req->flags, RRF_WATCH)) {
+			if (!GET_FLAG(req->flags, RRF_READY)) {
+				prior = &req->next;
+				continue;
+			}
+			CLR_FLAG(req->flags, RRF_READY);
+		}
+
 		// Call command again:
 		if (req->command < RDC_MAX)
 			result = dev->commands[req->command](req);
@@ -217,9 +226,10 @@ static int Poll_Default(REBDEV *dev)
 
 /***********************************************************************
 **
-*/	void Signal_Device(REBREQ *req, REBINT type)
+*/	int Signal_Device(REBREQ *req, REBINT type)
 /*
 **		Generate a device event to awake a port on REBOL.
+**		Returns 0 if the event queue is full (event not sent).
 **
 ***********************************************************************/
 {
@@ -232,7 +242,7 @@ static int Poll_Default(REBDEV *dev)
 	evt.req  = req;
 	if (type == EVT_ERROR) evt.data = req->error;
 
-	RL_Event(&evt);	// (returns 0 if queue is full, ignored)
+	return RL_Event(&evt);	// (returns 0 if queue is full)
 }
 
 
@@ -406,6 +416,36 @@ static int Poll_Default(REBDEV *dev)
 }
 
 
+/***********************************************************************
+**
+*/	int Idle_Devices(void)
+/*
+**		Return the longest msec a WAIT can block in the event
+**		device, or zero if a device needs polling. Requests in the
+**		OS readiness set (RRF_WATCH) need none. An auto-polled
+**		device with a poll_time needs a poll within that time.
+**
+***********************************************************************/
+{
+	int d;
+	int most = MAX_I32;
+	REBDEV *dev;
+	REBREQ *req;
+
+	for (d = 0; d < RDI_MAX; d++) {
+		if (d == RDI_EVENT || !(dev = Devices[d])) continue;
+		if (GET_FLAG(dev->flags, RDO_AUTO_POLL)) {
+			if (!dev->poll_time) return 0;
+			if ((int)dev->poll_time < most) most = dev->poll_time;
+		}
+		for (req = dev->pending; req; req = req->next)
+			if (!GET_FLAG(req->flags, RRF_WATCH)) return 0;
+	}
+
+	return most;
+}
+
+
 /***********************************************************************
 **
 */	int OS_Quit_Devices(int flags)
@@ -472,7 +512,13 @@ static int Poll_Default(REBDEV *dev)
 
 	// Nothing, so wait for period of time
 	delta = (REBCNT)OS_Delta_Time(base, 0)/1000 + res;
-	if (delta >= millisec) return 0;
+	if (delta >= millisec) {
+		// No time to sleep, but still check the watched requests
+		// (polling skips them until they are marked ready):
+		req.length = 0;
+		OS_Do_Device(&req, RDC_QUERY);
+		return OS_Poll_Devices() ? -1 : 0;
+	}
 	millisec -= delta;  // account for time lost above
 	req.length = millisec;
 
@@ -144,10 +144,14 @@ static void *Task_Ready;
 ***********************************************************************/
 {
 #define OCID_STACK_SIZE 1  // needs to move to .h file
+#define OCID_CPU_COUNT  2
+#define OCID_MAX_WAIT   3
 
 	switch (id) {
 	case OCID_STACK_SIZE:
 		return 0;  // (size in bytes should be returned here)
+	case OCID_CPU_COUNT:
+		return 1;  // (number of processors should be returned here)
 	}
 
 	return 0;
@@ -482,6 +486,34 @@ static void *Task_Ready;
 }
 
 
+/***********************************************************************
+**
+*/	void *OS_Map_File(REBREQ *file, i64 offset, REBCNT len)
+/*
+**		Map len bytes of an open file, from offset, into memory.
+**		The map is copy-on-write, and one more byte after the
+**		data must be mapped (and zeroed) for a series terminator.
+**
+**		Returns the address of the data, or zero if the file
+**		can not be mapped (the caller should read it instead).
+**
+***********************************************************************/
+{
+	return 0; // (not supported, files are read)
+}
+
+
+/***********************************************************************
+**
+*/	void OS_Unmap_File(void *data, REBCNT len)
+/*
+**		Release a map made by OS_Map_File.
+**
+***********************************************************************/
+{
+}
+
+
 /***********************************************************************
 **
 */	void *OS_Open_Library(REBCHR *path, REBCNT *error)
@@ -587,6 +619,26 @@ static void *Task_Ready;
 }
 
 
+/***********************************************************************
+**
+*/	REBINT OS_Run_Threads(CFUNC func, void **args, REBCNT count)
+/*
+**		Call func for each of the args in parallel and return when
+**		all of the calls are done. The last call (and any that can
+**		not get a thread of their own) runs on the calling thread.
+**		Returns the number of extra threads that were used.
+**
+***********************************************************************/
+{
+	REBCNT n;
+
+	// (start threads here; this version runs the calls in turn)
+	for (n = 0; n < count; n++) func(args[n]);
+
+	return 0;
+}
+
+
 /***********************************************************************
 **
 */	int OS_Create_Process(REBCHR *call, u32 flags)
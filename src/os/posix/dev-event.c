@@ -40,11 +40,20 @@
 #include <stdio.h>
 #include <string.h>
 #include <unistd.h>
+#include <errno.h>
 #include <sys/time.h>
 
 #include "reb-host.h"
 #include "host-lib.h"
 
+#ifdef HAS_EPOLL
+#include <sys/epoll.h>
+
+#define MAX_READY 64		// ready sockets taken per epoll_wait
+
+static int Epoll_FD = -1;	// readiness set of pending sockets
+#endif
+
 void Done_Device(int handle, int error);
 
 /***********************************************************************
@@ -64,6 +73,69 @@ void Done_Device(int handle, int error);
 }
 
 
+/***********************************************************************
+**
+*/	DEVICE_CMD Quit_Events(REBREQ *dr)
+/*
+**		Release the readiness set.
+**
+***********************************************************************/
+{
+	REBDEV *dev = (REBDEV*)dr;
+#ifdef HAS_EPOLL
+	if (Epoll_FD >= 0) close(Epoll_FD);
+	Epoll_FD = -1;
+#endif
+	CLR_FLAG(dev->flags, RDF_INIT);
+	return DR_DONE;
+}
+
+
+#ifdef HAS_EPOLL
+/***********************************************************************
+**
+*/	int Watch_Socket(REBREQ *sock, int events)
+/*
+**		Add a pending socket request to the readiness set, waiting
+**		for the given EPOLLIN or EPOLLOUT events, or remove it
+**		when events is zero.
+**
+**		A watched request is not retried by the device poll until
+**		Query_Events sees it ready (RRF_READY). If it cannot be
+**		watched, it stays unwatched and is polled as before.
+**
+**		The request address is what epoll reports back, so it
+**		must be unwatched before the request is moved or freed.
+**
+***********************************************************************/
+{
+	struct epoll_event ev;
+	int op;
+
+	CLR_FLAG(sock->flags, RRF_READY);
+	CLEARS(&ev); // (old kernels want it, even for DEL)
+
+	if (!events) {
+		if (!GET_FLAG(sock->flags, RRF_WATCH)) return 0;
+		CLR_FLAG(sock->flags, RRF_WATCH);
+		return epoll_ctl(Epoll_FD, EPOLL_CTL_DEL, sock->socket, &ev);
+	}
+
+	if (Epoll_FD < 0 && (Epoll_FD = epoll_create(MAX_READY)) < 0) return -1;
+
+	ev.events = events;
+	ev.data.ptr = sock;
+	op = GET_FLAG(sock->flags, RRF_WATCH) ? EPOLL_CTL_MOD : EPOLL_CTL_ADD;
+	if (epoll_ctl(Epoll_FD, op, sock->socket, &ev)) {
+		CLR_FLAG(sock->flags, RRF_WATCH);
+		return -1;
+	}
+	SET_FLAG(sock->flags, RRF_WATCH);
+	return 0;
+}
+#endif
+
+
 /***********************************************************************
 **
 */	DEVICE_CMD Poll_Events(REBREQ *req)
@@ -85,17 +157,32 @@ void Done_Device(int handle, int error);
 **		Wait for an event or a timeout sepecified by req->length.
 **		This is used by WAIT as the main timing method.
 **
+**		With epoll, the wait ends as soon as a watched socket is
+**		ready, and only those requests are marked for retry.
+**
 ***********************************************************************/
 {
 	struct timeval tv;
 	int result;
+#ifdef HAS_EPOLL
+	struct epoll_event ready[MAX_READY];
+
+	if (Epoll_FD >= 0) {
+		result = epoll_wait(Epoll_FD, ready, MAX_READY, (int)req->length);
+		if (result < 0) return (errno == EINTR) ? DR_DONE : DR_ERROR;
+		while (result-- > 0)
+			SET_FLAG(((REBREQ*)ready[result].data.ptr)->flags, RRF_READY);
+		return DR_DONE;
+	}
+#endif
 
-	tv.tv_sec = 0;
-	tv.tv_usec = req->length * 1000;
+	tv.tv_sec = req->length / 1000;
+	tv.tv_usec = (req->length % 1000) * 1000;
 	//printf("usec %d\n", tv.tv_usec);
-	
+
 	result = select(0, 0, 0, 0, &tv);
 	if (result < 0) {
+		if (errno == EINTR) return DR_DONE; // signal (e.g. escape)
 		// !!! set error code
 		printf("ERROR!!!!\n");
 		return DR_ERROR;
@@ -126,7 +213,7 @@ void Done_Device(int handle, int error);
 
 static DEVICE_CMD_FUNC Dev_Cmds[RDC_MAX] = {
 	Init_Events,			// init device driver resources
-	0,	// RDC_QUIT,		// cleanup device driver resources
+	Quit_Events,			// cleanup device driver resources
 	0,	// RDC_OPEN,		// open device unit (port)
 	0,	// RDC_CLOSE,		// close device unit
 	0,	// RDC_READ,		// read from unit
@@ -49,6 +49,20 @@
 #include "reb-host.h"
 #include "host-lib.h"
 
+#include <stdlib.h>
+
+#ifdef HAS_FILE_THREADS
+#include <pthread.h>
+#endif
+
+#ifdef HAS_EPOLL
+#include <sys/epoll.h>
+int Watch_Socket(REBREQ *sock, int events);
+#endif
+
+extern int Signal_Device(REBREQ *req, REBINT type);
+extern REBDEV Dev_File;
+
 #ifndef O_BINARY
 #define O_BINARY 0
 #endif
@@ -136,6 +150,433 @@ static int Get_File_Info(REBREQ *file)
 }
 
 
+#ifdef HAS_FILE_THREADS
+/***********************************************************************
+**
+**	Threaded I/O
+**
+**		A read or write of an RFM_ASYNC file is done by one of a
+**		few worker threads, using pread and pwrite at the file
+**		index (the handle position is never moved by a worker).
+**		The main thread sees the result when it polls (Poll_File),
+**		woken by a byte on a pipe that the event reactor watches,
+**		the same as the threaded DNS lookups.
+**
+**		A file has at most one job. It is kept in file->file.job
+**		for reuse, and freed on close (which waits for a running
+**		job, because the job writes into the request data).
+**
+***********************************************************************/
+
+#define FILE_THREADS 4		// most worker threads
+
+enum {
+	FILE_IDLE,
+	FILE_QUEUED,
+	FILE_RUNNING,
+	FILE_DONE
+};
+
+typedef struct file_job {
+	struct file_job *next;	// work queue link
+	int state;				// FILE_IDLE, etc.
+	int write;				// write (else read)
+	int trunc;				// truncate at offset before the write
+	int id;					// file handle
+	REBYTE *data;
+	u32 length;
+	i64 offset;				// file position (-1 to append)
+	i64 actual;				// bytes done (or -1)
+	int error;				// RFE_ code
+} FILEJOB;
+
+static pthread_mutex_t File_Lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t File_Work = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t File_Done = PTHREAD_COND_INITIALIZER;
+static FILEJOB *File_Queue = 0;
+static FILEJOB **File_Tail = &File_Queue;
+static int File_Workers = 0;	// threads started
+static int File_Idle = 0;		// threads waiting for work
+static int File_Pipe[2] = {-1, -1};
+static REBREQ File_Wake;		// reactor request for the pipe
+
+
+static void Do_File_Job(FILEJOB *job)
+{
+	// Do the read or write. Runs in a worker thread.
+	struct stat info;
+	ssize_t n = 0;
+	u32 done = 0;
+
+	if (job->offset < 0) {
+		if (fstat(job->id, &info)) {
+			job->error = RFE_NO_SEEK;
+			return;
+		}
+		job->offset = info.st_size;
+	}
+
+	if (!job->write) {
+		while ((n = pread(job->id, job->data, job->length, job->offset)) < 0 && errno == EINTR);
+		if (n < 0) job->error = RFE_BAD_READ;
+		else job->actual = n;
+		return;
+	}
+
+	if (job->trunc && ftruncate(job->id, job->offset)) {
+		job->error = RFE_BAD_WRITE;
+		return;
+	}
+
+	// Unlike a read, a write is done in full:
+	while (done < job->length) {
+		n = pwrite(job->id, job->data + done, job->length - done, job->offset + done);
+		if (n < 0) {
+			if (errno == EINTR) continue;
+			job->error = (errno == ENOSPC) ? RFE_DISK_FULL : RFE_BAD_WRITE;
+			return;
+		}
+		done += n;
+	}
+	job->actual = done;
+}
+
+
+static void *File_Worker(void *arg)
+{
+	FILEJOB *job;
+
+	pthread_mutex_lock(&File_Lock);
+	for (;;) {
+		while (!(job = File_Queue)) {
+			File_Idle++;
+			pthread_cond_wait(&File_Work, &File_Lock);
+			File_Idle--;
+		}
+		if (!(File_Queue = job->next)) File_Tail = &File_Queue;
+		job->state = FILE_RUNNING;
+		pthread_mutex_unlock(&File_Lock);
+
+		Do_File_Job(job);
+
+		pthread_mutex_lock(&File_Lock);
+		job->state = FILE_DONE;
+		pthread_cond_broadcast(&File_Done);
+		if (write(File_Pipe[1], "", 1) < 0) {} // full pipe is ok
+	}
+	return 0;
+}
+
+
+static int Start_File_Workers(void)
+{
+	// Setup the wakeup pipe and start a worker if none is idle.
+	// Called with the lock held. Returns FALSE on failure.
+	pthread_t thread;
+	int n;
+
+	if (File_Pipe[0] < 0) {
+		if (pipe(File_Pipe)) return FALSE;
+		for (n = 0; n < 2; n++) {
+			fcntl(File_Pipe[n], F_SETFL, O_NONBLOCK);
+			fcntl(File_Pipe[n], F_SETFD, FD_CLOEXEC);
+		}
+#ifdef HAS_EPOLL
+		File_Wake.device = RDI_FILE;
+		File_Wake.socket = File_Pipe[0];
+		Watch_Socket(&File_Wake, EPOLLIN);
+#endif
+	}
+
+	if (File_Idle == 0 && File_Workers < FILE_THREADS) {
+		if (pthread_create(&thread, 0, File_Worker, 0)) return File_Workers > 0;
+		pthread_detach(thread);
+		File_Workers++;
+	}
+	return TRUE;
+}
+
+
+static int Start_File_Job(REBREQ *file, int write)
+{
+	// Queue a read or write of the request for a worker.
+	// Returns DR_PEND (Poll_File finishes it) or DR_ERROR.
+	FILEJOB *job = (FILEJOB*)file->file.job;
+
+	if (!job) {
+		if (!(job = malloc(sizeof(FILEJOB)))) {
+			file->error = -(write ? RFE_BAD_WRITE : RFE_BAD_READ);
+			return DR_ERROR;
+		}
+		CLEARS(job);
+		file->file.job = job;
+	}
+
+	pthread_mutex_lock(&File_Lock);
+	if (job->state == FILE_QUEUED || job->state == FILE_RUNNING) {
+		pthread_mutex_unlock(&File_Lock);
+		file->error = -RFE_BUSY;
+		return DR_ERROR;
+	}
+	if (!Start_File_Workers()) {
+		pthread_mutex_unlock(&File_Lock);
+		file->error = -(write ? RFE_BAD_WRITE : RFE_BAD_READ);
+		return DR_ERROR;
+	}
+
+	job->state = FILE_QUEUED;
+	job->next = 0;
+	job->write = write;
+	job->trunc = write && GET_FLAG(file->modes, RFM_TRUNCATE);
+	job->id = file->id;
+	job->data = file->data;
+	job->length = file->length;
+	job->offset = GET_FLAG(file->modes, RFM_APPEND) ? -1 : file->file.index;
+	job->actual = 0;
+	job->error = 0;
+	CLR_FLAG(file->modes, RFM_APPEND);
+
+	*File_Tail = job;
+	File_Tail = &job->next;
+	pthread_cond_signal(&File_Work);
+	pthread_mutex_unlock(&File_Lock);
+
+	file->actual = 0;
+#ifdef HAS_EPOLL
+	// The reactor wakes WAIT when a worker is done:
+	if (GET_FLAG(File_Wake.flags, RRF_WATCH)) SET_FLAG(file->flags, RRF_WATCH);
+#endif
+	return DR_PEND;
+}
+
+
+static int Check_File_Job(REBREQ *file)
+{
+	// Finish the job of a request, if the worker is done with it.
+	// Returns DR_PEND, DR_DONE, or DR_ERROR (file->error set).
+	FILEJOB *job = (FILEJOB*)file->file.job;
+	int state;
+
+	if (!job) return DR_ERROR;
+
+	pthread_mutex_lock(&File_Lock);
+	state = job->state;
+	pthread_mutex_unlock(&File_Lock);
+	if (state != FILE_DONE) return DR_PEND;
+	job->state = FILE_IDLE;
+
+	if (job->error) {
+		file->error = -job->error;
+		return DR_ERROR;
+	}
+
+	file->actual = (u32)job->actual;
+	file->file.index = job->offset + job->actual;
+	if (file->file.index > file->file.size) file->file.size = file->file.index;
+	SET_FLAG(file->modes, RFM_RESEEK); // (the handle was not moved)
+	return DR_DONE;
+}
+
+
+static void Free_File_Job(REBREQ *file)
+{
+	// Release the job of a request, waiting for it if running.
+	FILEJOB *job = (FILEJOB*)file->file.job;
+	FILEJOB **node;
+
+	file->file.job = 0;
+	CLR_FLAG(file->flags, RRF_WATCH);
+	if (!job) return;
+
+	pthread_mutex_lock(&File_Lock);
+	if (job->state == FILE_QUEUED) {
+		for (node = &File_Queue; *node != job; node = &(*node)->next);
+		if (!(*node = job->next)) File_Tail = node;
+	}
+	while (job->state == FILE_RUNNING) pthread_cond_wait(&File_Done, &File_Lock);
+	pthread_mutex_unlock(&File_Lock);
+	free(job);
+}
+#endif // HAS_FILE_THREADS
+
+
+/***********************************************************************
+**
+**	Write Buffering
+**
+**		A file opened with a buffer size (from the port spec) holds
+**		small writes in a buffer and writes them out together. The
+**		held bytes are written before any other read, write, seek,
+**		or query of the file, when the buffer is full, on close,
+**		and once they are FLUSH_TIME old. Opening, reading or
+**		querying the same file by another request writes them too.
+**		Quit writes out all held bytes.
+**
+**		While bytes are held, the device is auto-polled with a
+**		poll_time of FLUSH_TIME, so a WAIT still sleeps (up to that
+**		long) and Poll_File writes out the old bytes.
+**
+**		Seek mode, async, and truncating writes are not held.
+**		A held write has no error; an error found when the bytes
+**		are written later is returned by the next call.
+**
+**		A buffer exists only while it holds bytes (or an error),
+**		and is freed once they are written. So bytes held by a
+**		port that was not closed are still written, and their
+**		buffer is not lost. (The request of an open port is not
+**		freed, see Use_Port_State.)
+**
+***********************************************************************/
+
+#define FLUSH_TIME 1000000	// microseconds bytes can be held
+
+typedef struct file_buffer {
+	struct file_buffer *next;	// list of buffers holding bytes
+	REBREQ *file;			// the request using it
+	dev_t dev;				// the file (for other requests of it)
+	ino_t ino;
+	int error;				// RFE_ code of a later write (or 0)
+	i64 offset;				// where the bytes go (-1 end, -2 handle position)
+	i64 start;				// time the first byte was held
+	u32 length;				// bytes held
+	REBYTE data[4];			// (extends past the struct)
+} FILEBUF;
+
+#define AT_HANDLE -2		// FILEBUF offset for the handle position
+
+static FILEBUF *File_Held = 0;
+
+
+static int Write_Buffer(FILEBUF *buf)
+{
+	// Write out the held bytes and take the buffer off the
+	// held list. Returns the RFE_ error or 0.
+	FILEBUF **node;
+	REBYTE *data;
+	u32 len;
+	ssize_t n;
+	i64 result = 0;
+
+	if (!buf->length) return 0;
+
+	for (node = &File_Held; *node != buf; node = &(*node)->next);
+	*node = buf->next;
+	if (!File_Held) CLR_FLAG(Dev_File.flags, RDO_AUTO_POLL);
+
+	data = buf->data;
+	len = buf->length;
+	buf->length = 0;
+
+	if (buf->offset == -1) result = lseek(buf->file->id, 0, SEEK_END);
+	else if (buf->offset >= 0) result = lseek(buf->file->id, buf->offset, SEEK_SET);
+	if (result < 0) return RFE_NO_SEEK;
+
+	while (len > 0) {
+		n = write(buf->file->id, data, len);
+		if (n < 0) {
+			if (errno == EINTR) continue;
+			return (errno == ENOSPC) ? RFE_DISK_FULL : RFE_BAD_WRITE;
+		}
+		data += n;
+		len -= n;
+	}
+	return 0;
+}
+
+
+static void Flush_Held(REBOOL old, struct stat *info)
+{
+	// Write out the held bytes of all files, or just those that
+	// are FLUSH_TIME old, or those of the file with the info.
+	// An error is kept for the next call.
+	FILEBUF *buf;
+	FILEBUF *next;
+
+	for (buf = File_Held; buf; buf = next) {
+		next = buf->next;
+		if (old && OS_Delta_Time(buf->start, 0) < FLUSH_TIME) continue;
+		if (info && (buf->dev != info->st_dev || buf->ino != info->st_ino)) continue;
+		if (!(buf->error = Write_Buffer(buf))) {
+			buf->file->file.buffer = 0;
+			free(buf);
+		}
+	}
+}
+
+
+static int Flush_File(REBREQ *file)
+{
+	// Write out the bytes held for a file, and free its buffer.
+	// TRUE on success. On error, returns FALSE and sets the
+	// file->error field.
+	FILEBUF *buf = (FILEBUF*)file->file.buffer;
+	int error;
+
+	if (!buf) return TRUE;
+	error = buf->error ? buf->error : Write_Buffer(buf);
+	file->file.buffer = 0;
+	free(buf);
+	if (!error) return TRUE;
+	file->error = -error;
+	return FALSE;
+}
+
+
+static int Hold_Write(REBREQ *file)
+{
+	// Add the write to the held bytes of the file, writing them
+	// out first if it does not follow them (or they are old).
+	// Returns DR_DONE, DR_ERROR, or DR_PEND if the write cannot
+	// be held.
+	FILEBUF *buf = (FILEBUF*)file->file.buffer;
+	u32 size = file->file.buffer_size;
+	i64 offset = AT_HANDLE;
+	struct stat info;
+
+	if (file->length >= size) return DR_PEND;
+
+	// Where the write goes:
+	if (GET_FLAG(file->modes, RFM_APPEND)) offset = -1;
+	else if (GET_FLAG(file->modes, RFM_RESEEK)) offset = file->file.index;
+
+	if (buf && (
+		buf->error
+		|| buf->length + file->length > size
+		|| (offset == -1 && buf->offset != -1)
+		|| (offset >= 0 && (buf->offset < 0 || offset != buf->offset + buf->length))
+		|| OS_Delta_Time(buf->start, 0) >= FLUSH_TIME
+	)) {
+		if (!Flush_File(file)) return DR_ERROR;
+		buf = 0;
+	}
+
+	if (!buf) {
+		if (fstat(file->id, &info)) return DR_PEND;
+		if (!(buf = malloc(sizeof(FILEBUF) + size))) return DR_PEND;
+		CLEARS(buf);
+		buf->file = file;
+		buf->dev = info.st_dev;
+		buf->ino = info.st_ino;
+		buf->offset = offset;
+		buf->start = OS_Delta_Time(0, 0);
+		buf->next = File_Held;
+		File_Held = buf;
+		file->file.buffer = buf;
+		Dev_File.poll_time = FLUSH_TIME / 1000;
+		SET_FLAG(Dev_File.flags, RDO_AUTO_POLL);
+	}
+	CLR_FLAG(file->modes, RFM_APPEND);
+	CLR_FLAG(file->modes, RFM_RESEEK); // (the buffer has the position)
+
+	memcpy(buf->data + buf->length, file->data, file->length);
+	buf->length += file->length;
+	file->actual = file->length;
+
+	if (buf->length == size && !Flush_File(file)) return DR_ERROR;
+	return DR_DONE;
+}
+
+
 /***********************************************************************
 **
 */	static int Read_Directory(REBREQ *dir, REBREQ *file)
@@ -309,6 +750,11 @@ static int Get_File_Info(REBREQ *file)
 
 	// Fetch file size (if fails, then size is assumed zero):
 	if (fstat(h, &info) == 0) {
+		// Bytes held by another request come first:
+		if (File_Held) {
+			Flush_Held(FALSE, &info);
+			fstat(h, &info);
+		}
 		file->file.size = info.st_size;
 		file->file.time.l = (long)(info.st_mtime);
 	}
@@ -330,11 +776,17 @@ fail:
 **
 ***********************************************************************/
 {
+	int result = DR_DONE;
+
+#ifdef HAS_FILE_THREADS
+	Free_File_Job(file); // (before the handle is closed)
+#endif
+	if (!Flush_File(file)) result = DR_ERROR;
 	if (file->id) {
 		close(file->id);
 		file->id = 0;
 	}
-	return DR_DONE;
+	return result;
 }
 
 
@@ -344,6 +796,8 @@ fail:
 /*
 ***********************************************************************/
 {
+	struct stat info;
+
 	if (GET_FLAG(file->modes, RFM_DIR)) {
 		return Read_Directory(file, (REBREQ*)file->data);
 	}
@@ -353,6 +807,15 @@ fail:
 		return DR_ERROR;
 	}
 
+	// Bytes held by other requests of the file come first:
+	if (File_Held && fstat(file->id, &info) == 0) Flush_Held(FALSE, &info);
+
+#ifdef HAS_FILE_THREADS
+	if (GET_FLAG(file->modes, RFM_ASYNC)) return Start_File_Job(file, FALSE);
+#endif
+
+	if (!Flush_File(file)) return DR_ERROR;
+
 	if (file->modes & ((1 << RFM_SEEK) | (1 << RFM_RESEEK))) {
 		CLR_FLAG(file->modes, RFM_RESEEK);
 		if (!Seek_File_64(file)) return DR_ERROR;
@@ -367,6 +830,13 @@ fail:
 		file->file.index += file->actual;
 	}
 
+#ifndef HAS_FILE_THREADS
+	// Done now, but reported as an event (see Poll_File):
+	if (GET_FLAG(file->modes, RFM_ASYNC)) {
+		SET_FLAG(file->flags, RRF_DONE);
+		return DR_PEND;
+	}
+#endif
 	return DR_DONE;
 }
 
@@ -384,6 +854,23 @@ fail:
 		return DR_ERROR;
 	}
 
+#ifdef HAS_FILE_THREADS
+	if (GET_FLAG(file->modes, RFM_ASYNC) && file->length > 0) return Start_File_Job(file, TRUE);
+#endif
+
+	// Hold small writes (see Write Buffering):
+	if (
+		file->file.buffer_size && file->length > 0
+		&& !(file->modes & ((1 << RFM_SEEK) | (1 << RFM_TRUNCATE) | (1 << RFM_ASYNC)))
+	) {
+		int result = Hold_Write(file);
+		if (result != DR_PEND) return result;
+	}
+
+	// Otherwise, write out held bytes first (a zero length write
+	// does only that):
+	if (!Flush_File(file)) return DR_ERROR;
+
 	if (GET_FLAG(file->modes, RFM_APPEND)) {
 		CLR_FLAG(file->modes, RFM_APPEND);
 		lseek(file->id, 0, SEEK_END);
@@ -405,6 +892,15 @@ fail:
 		return DR_ERROR;
 	}
 
+#ifndef HAS_FILE_THREADS
+	// Done now, but reported as an event (see Poll_File):
+	if (GET_FLAG(file->modes, RFM_ASYNC)) {
+		file->file.index += file->actual;
+		if (file->file.index > file->file.size) file->file.size = file->file.index;
+		SET_FLAG(file->flags, RRF_DONE);
+		return DR_PEND;
+	}
+#endif
 	return DR_DONE;
 }
 
@@ -418,8 +914,25 @@ fail:
 **
 **		Note: time is in local format and must be converted
 **
+**		Held writes are written out first, so the size is right.
+**		An open file is queried by its handle.
+**
 ***********************************************************************/
 {
+	struct stat info;
+
+	if (!file->id) {
+		// Bytes may be held by a port of the file:
+		if (File_Held && stat(file->file.path, &info) == 0) Flush_Held(FALSE, &info);
+	}
+	else {
+		if (!Flush_File(file)) return DR_ERROR;
+		if (fstat(file->id, &info) == 0) {
+			file->file.size = info.st_size;
+			file->file.time.l = (long)(info.st_mtime);
+			return DR_DONE;
+		}
+	}
 	return Get_File_Info(file);
 }
 
@@ -480,11 +993,69 @@ fail:
 
 /***********************************************************************
 **
-*/	DEVICE_CMD Poll_File(REBREQ *file)
+*/	DEVICE_CMD Quit_File(REBREQ *dr)
+/*
+**		Write out all held bytes.
+**
+***********************************************************************/
+{
+	Flush_Held(FALSE, 0);
+	return DR_DONE;
+}
+
+
+/***********************************************************************
+**
+*/	DEVICE_CMD Poll_File(REBREQ *dr)
 /*
+**		Check for completed reads and writes of RFM_ASYNC files.
+**		These are finished by a worker thread (HAS_FILE_THREADS),
+**		or were done at once and marked with RRF_DONE.
+**		Completed requests are removed from the pending queue and
+**		event is signalled (for awake dispatch).
+**
+**		Also writes out held bytes that are FLUSH_TIME old.
+**
 ***********************************************************************/
 {
-	return DR_DONE;		// files are synchronous (currently)
+	REBDEV *dev = (REBDEV*)dr;  // to keep compiler happy
+	REBREQ **prior = &dev->pending;
+	REBREQ *req;
+	REBOOL change = FALSE;
+	int result;
+#ifdef HAS_FILE_THREADS
+	char drain[64];
+#endif
+
+	Flush_Held(TRUE, 0);
+
+#ifdef HAS_FILE_THREADS
+	// Empty the wakeup pipe (one byte per finished job):
+	if (File_Pipe[0] >= 0) while (read(File_Pipe[0], drain, sizeof(drain)) > 0);
+	CLR_FLAG(File_Wake.flags, RRF_READY);
+#endif
+
+	for (req = *prior; req; req = *prior) {
+#ifdef HAS_FILE_THREADS
+		result = Check_File_Job(req);
+#else
+		result = GET_FLAG(req->flags, RRF_DONE) ? DR_DONE : DR_PEND;
+#endif
+		if (result == DR_PEND) {
+			prior = &req->next;
+			continue;
+		}
+		*prior = req->next;
+		req->next = 0;
+		CLR_FLAG(req->flags, RRF_PENDING);
+		CLR_FLAG(req->flags, RRF_WATCH);
+		CLR_FLAG(req->flags, RRF_DONE);
+		if (result == DR_ERROR) Signal_Device(req, EVT_ERROR);
+		else Signal_Device(req, req->command == RDC_WRITE ? EVT_WROTE : EVT_READ);
+		change = TRUE;
+	}
+
+	return change;
 }
 
 
@@ -496,7 +1067,7 @@ fail:
 
 static DEVICE_CMD_FUNC Dev_Cmds[RDC_MAX] = {
 	0,
-	0,
+	Quit_File,
 	Open_File,
 	Close_File,
 	Read_File,
@@ -57,6 +57,8 @@
 #include <sys/wait.h>
 #include <time.h>
 #include <string.h>
+#include <pthread.h>
+#include <sys/mman.h>
 
 #ifndef timeval // for older systems
 #include <sys/time.h>
@@ -76,6 +78,14 @@ static void *Task_Ready;
 #define PATH_MAX 4096  // generally lacking in Posix
 #endif
 
+#ifndef MAP_ANONYMOUS
+#define MAP_ANONYMOUS MAP_ANON  // older BSD name
+#endif
+
+#ifdef HAS_EPOLL
+int Idle_Devices(void);
+#endif
+
 
 
 /***********************************************************************
@@ -143,10 +153,20 @@ static void *Task_Ready;
 ***********************************************************************/
 {
 #define OCID_STACK_SIZE 1  // needs to move to .h file
+#define OCID_CPU_COUNT  2
+#define OCID_MAX_WAIT   3
 
 	switch (id) {
 	case OCID_STACK_SIZE:
 		return 0;  // (size in bytes should be returned here)
+	case OCID_CPU_COUNT:
+		return (REBINT)sysconf(_SC_NPROCESSORS_ONLN);
+	case OCID_MAX_WAIT:
+		// Longest WAIT sleep that misses no device (0 = default):
+#ifdef HAS_EPOLL
+		return Idle_Devices();
+#endif
+		return 0;
 	}
 
 	return 0;
@@ -481,6 +501,55 @@ static void *Task_Ready;
 }
 
 
+/***********************************************************************
+**
+*/	void *OS_Map_File(REBREQ *file, i64 offset, REBCNT len)
+/*
+**		Map len bytes of an open file, from offset, into memory.
+**		The map is copy-on-write: changes stay private and are
+**		never written to the file. One more byte after the data
+**		is always mapped (and zeroed) for a series terminator.
+**
+**		Returns the address of the data, or zero if the file
+**		can not be mapped (the caller should read it instead).
+**
+***********************************************************************/
+{
+	long page = sysconf(_SC_PAGESIZE);
+	i64 base = offset - (offset % page);
+	size_t span = (size_t)(offset - base) + len;
+	REBYTE *addr;
+
+	if (!file->id || !len) return 0;
+
+	// Reserve a page more than the file part, then map the file over it:
+	addr = mmap(0, span + page, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (addr == MAP_FAILED) return 0;
+	if (mmap(addr, span, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED, file->id, base) == MAP_FAILED) {
+		munmap(addr, span + page);
+		return 0;
+	}
+	addr[span] = 0;
+
+	return addr + (offset - base);
+}
+
+
+/***********************************************************************
+**
+*/	void OS_Unmap_File(void *data, REBCNT len)
+/*
+**		Release a map made by OS_Map_File.
+**
+***********************************************************************/
+{
+	long page = sysconf(_SC_PAGESIZE);
+	size_t skip = (size_t)data % page;
+
+	munmap((REBYTE*)data - skip, skip + len + page);
+}
+
+
 /***********************************************************************
 **
 */	void *OS_Open_Library(REBCHR *path, REBCNT *error)
@@ -586,6 +655,65 @@ static void *Task_Ready;
 }
 
 
+typedef struct thread_call {
+	CFUNC func;
+	void *arg;
+	pthread_t thread;
+} THREAD_CALL;
+
+/***********************************************************************
+**
+*/	static void *Thread_Call(void *call)
+/*
+***********************************************************************/
+{
+	((THREAD_CALL *)call)->func(((THREAD_CALL *)call)->arg);
+	return 0;
+}
+
+
+/***********************************************************************
+**
+*/	REBINT OS_Run_Threads(CFUNC func, void **args, REBCNT count)
+/*
+**		Call func for each of the args in parallel and return when
+**		all of the calls are done. The last call (and any that can
+**		not get a thread of their own) runs on the calling thread.
+**		Returns the number of extra threads that were used.
+**
+***********************************************************************/
+{
+	THREAD_CALL *calls;
+	REBINT started = 0;
+	REBCNT n;
+
+	if (count == 0) return 0;
+
+	calls = malloc(count * sizeof(THREAD_CALL));
+	for (n = 0; n < count - 1; n++) {
+		if (calls) {
+			calls[n].func = func;
+			calls[n].arg = args[n];
+			if (!pthread_create(&calls[n].thread, 0, Thread_Call, &calls[n])) {
+				started++;
+				continue;
+			}
+			calls[n].func = 0;
+		}
+		func(args[n]);
+	}
+	func(args[count - 1]);
+
+	if (calls) {
+		for (n = 0; n < count - 1; n++) {
+			if (calls[n].func) pthread_join(calls[n].thread, 0);
+		}
+		free(calls);
+	}
+	return started;
+}
+
+
 /***********************************************************************
 **
 */	int OS_Create_Process(REBCHR *call, u32 flags)
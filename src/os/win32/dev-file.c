@@ -42,6 +42,8 @@
 #include "reb-host.h"
 #include "host-lib.h"
 
+extern int Signal_Device(REBREQ *req, REBINT type);
+
 // MSDN V6 missed this define:
 #ifndef INVALID_SET_FILE_POINTER
 #define INVALID_SET_FILE_POINTER ((DWORD)-1)
@@ -304,6 +306,11 @@ fail:
 		file->file.index += file->actual;
 	}
 
+	// Done now, but reported as an event (see Poll_File):
+	if (GET_FLAG(file->modes, RFM_ASYNC)) {
+		SET_FLAG(file->flags, RRF_DONE);
+		return DR_PEND;
+	}
 	return DR_DONE;
 }
 
@@ -354,6 +361,12 @@ fail:
 
 	file->file.size = ((i64)size_high << 32) + (i64)size_low;
 
+	// Done now, but reported as an event (see Poll_File):
+	if (GET_FLAG(file->modes, RFM_ASYNC) && file->length != 0) {
+		file->file.index += file->actual;
+		SET_FLAG(file->flags, RRF_DONE);
+		return DR_PEND;
+	}
 	return DR_DONE;
 }
 
@@ -439,11 +452,34 @@ fail:
 
 /***********************************************************************
 **
-*/	DEVICE_CMD Poll_File(REBREQ *file)
+*/	DEVICE_CMD Poll_File(REBREQ *dr)
 /*
+**		Signal the reads and writes of RFM_ASYNC files. These are
+**		done at once (marked with RRF_DONE), but are reported as
+**		events like those of other async ports. Completed requests
+**		are removed from the pending queue.
+**
 ***********************************************************************/
 {
-	return DR_DONE;		// files are synchronous (currently)
+	REBDEV *dev = (REBDEV*)dr;  // to keep compiler happy
+	REBREQ **prior = &dev->pending;
+	REBREQ *req;
+	REBOOL change = FALSE;
+
+	for (req = *prior; req; req = *prior) {
+		if (!GET_FLAG(req->flags, RRF_DONE)) {
+			prior = &req->next;
+			continue;
+		}
+		*prior = req->next;
+		req->next = 0;
+		CLR_FLAG(req->flags, RRF_PENDING);
+		CLR_FLAG(req->flags, RRF_DONE);
+		Signal_Device(req, req->command == RDC_WRITE ? EVT_WROTE : EVT_READ);
+		change = TRUE;
+	}
+
+	return change;
 }
 
 
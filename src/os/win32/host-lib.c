@@ -143,10 +143,17 @@ static void *Task_Ready;
 ***********************************************************************/
 {
 #define OCID_STACK_SIZE 1  // needs to move to .h file
+#define OCID_CPU_COUNT  2
+#define OCID_MAX_WAIT   3
+
+	SYSTEM_INFO info;
 
 	switch (id) {
 	case OCID_STACK_SIZE:
 		return 0;  // (size in bytes should be returned here)
+	case OCID_CPU_COUNT:
+		GetSystemInfo(&info);
+		return (REBINT)info.dwNumberOfProcessors;
 	}
 
 	return 0;
@@ -392,6 +399,59 @@ static void *Task_Ready;
 }
 
 
+/***********************************************************************
+**
+*/	void *OS_Map_File(REBREQ *file, i64 offset, REBCNT len)
+/*
+**		Map len bytes of an open file, from offset, into memory.
+**		The map is copy-on-write: changes stay private and are
+**		never written to the file. One more byte after the data
+**		must be in the view (and is zeroed) for a series terminator.
+**
+**		Returns the address of the data, or zero if the file
+**		can not be mapped (the caller should read it instead).
+**
+***********************************************************************/
+{
+	SYSTEM_INFO info;
+	HANDLE map;
+	REBYTE *addr;
+	i64 base;
+	DWORD span;
+
+	GetSystemInfo(&info);
+	base = offset - (offset % info.dwAllocationGranularity);
+	span = (DWORD)(offset - base) + len;
+
+	// A view ends at the file end, so the last page must have room:
+	if (!file->handle || !len || span % info.dwPageSize == 0) return 0;
+
+	map = CreateFileMapping((HANDLE)file->handle, 0, PAGE_WRITECOPY, 0, 0, 0);
+	if (!map) return 0;
+	addr = MapViewOfFile(map, FILE_MAP_COPY, (DWORD)(base >> 32), (DWORD)base, span);
+	CloseHandle(map); // (the view keeps it open)
+	if (!addr) return 0;
+	addr[span] = 0;
+
+	return addr + (offset - base);
+}
+
+
+/***********************************************************************
+**
+*/	void OS_Unmap_File(void *data, REBCNT len)
+/*
+**		Release a map made by OS_Map_File.
+**
+***********************************************************************/
+{
+	SYSTEM_INFO info;
+
+	GetSystemInfo(&info);
+	UnmapViewOfFile((REBYTE*)data - ((size_t)data % info.dwAllocationGranularity));
+}
+
+
 /***********************************************************************
 **
 */	i64 OS_Delta_Time(i64 base, int flags)
@@ -570,6 +630,67 @@ static void *Task_Ready;
 }
 
 
+typedef struct thread_call {
+	CFUNC func;
+	void *arg;
+	HANDLE thread;
+} THREAD_CALL;
+
+/***********************************************************************
+**
+*/	static unsigned __stdcall Thread_Call(void *call)
+/*
+***********************************************************************/
+{
+	((THREAD_CALL *)call)->func(((THREAD_CALL *)call)->arg);
+	return 0;
+}
+
+
+/***********************************************************************
+**
+*/	REBINT OS_Run_Threads(CFUNC func, void **args, REBCNT count)
+/*
+**		Call func for each of the args in parallel and return when
+**		all of the calls are done. The last call (and any that can
+**		not get a thread of their own) runs on the calling thread.
+**		Returns the number of extra threads that were used.
+**
+***********************************************************************/
+{
+	THREAD_CALL *calls;
+	REBINT started = 0;
+	REBCNT n;
+
+	if (count == 0) return 0;
+
+	calls = malloc(count * sizeof(THREAD_CALL));
+	for (n = 0; n < count - 1; n++) {
+		if (calls) {
+			calls[n].func = func;
+			calls[n].arg = args[n];
+			calls[n].thread = (HANDLE)_beginthreadex(0, 0, Thread_Call, &calls[n], 0, 0);
+			if (calls[n].thread) {
+				started++;
+				continue;
+			}
+		}
+		func(args[n]);
+	}
+	func(args[count - 1]);
+
+	if (calls) {
+		for (n = 0; n < count - 1; n++) {
+			if (!calls[n].thread) continue;
+			WaitForSingleObject(calls[n].thread, INFINITE);
+			CloseHandle(calls[n].thread);
+		}
+		free(calls);
+	}
+	return started;
+}
+
+
 /***********************************************************************
 **
 */	int OS_Create_Process(REBCHR *call, u32 flags)
@@ -0,0 +1,60 @@
+REBOL [
+	Title: "Benchmark: TCP accept rate on loopback"
+	Rights: {
+		Copyright 2012 REBOL Technologies
+		REBOL is a trademark of REBOL Technologies
+	}
+	License: {
+		Licensed under the Apache License, Version 2.0
+		See: http://www.apache.org/licenses/LICENSE-2.0
+	}
+	Purpose: {
+		Measures how many local loopback connections per second a
+		listen port accepts. Clients are opened in waves (so the
+		backlog fills up as in a connection storm) and each accepted
+		connection is closed at once. Run with: r3 bench-accept.r
+	}
+]
+
+port-num: 8765
+total: 20'000	; connections to accept
+wave: 200		; clients opened at once
+
+accepted: 0
+connected: 0
+
+server: open join tcp://: port-num
+server/awake: func [event /local client] [
+	if event/type = 'accept [
+		client: first event/port
+		close client
+		++ accepted
+	]
+	false
+]
+
+client-awake: func [event] [
+	switch event/type [
+		connect [++ connected close event/port]
+		error [close event/port]
+	]
+	false
+]
+
+print ["Accepting" total "connections, in waves of" wave]
+
+t: dt [
+	while [accepted < total] [
+		loop min wave total - accepted [
+			client: open join tcp://127.0.0.1: port-num
+			client/awake: :client-awake
+		]
+		wait [server 0.05]
+	]
+]
+
+close server
+
+print ["Time:" t]
+print ["Accepted:" accepted "connected:" connected]
+print ["Connections per second:" to integer! accepted / to decimal! t]
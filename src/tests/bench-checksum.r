@@ -0,0 +1,52 @@
+REBOL [
+	Title: "Benchmark: CHECKSUM methods"
+	Rights: {
+		Copyright 2012 REBOL Technologies
+		REBOL is a trademark of REBOL Technologies
+	}
+	License: {
+		Licensed under the Apache License, Version 2.0
+		See: http://www.apache.org/licenses/LICENSE-2.0
+	}
+	Purpose: {
+		Measures the throughput of each CHECKSUM method, for large
+		data and for many small messages (as in TLS records).
+		Run with: r3 bench-checksum.r
+	}
+]
+
+size: 16 * 1048576	; bytes of data
+small: 64			; bytes per small message
+rounds: 4			; large data is checksummed this many times
+
+methods: [crc32 sha1 sha256 md5]
+
+col: func [value width] [
+	value: form value
+	head insert/dup tail value " " width - length? value
+]
+
+mbs: func [bytes time] [
+	time: to decimal! time
+	either zero? time [0] [round/to bytes / 1048576 / time 0.1]
+]
+
+random/seed 1
+data: make binary! size
+loop size / 8 [append data to binary! random 2147483647] ; (8 bytes each)
+msg: copy/part data small
+
+print ["Data size:" size "bytes, small messages:" small "bytes"]
+print [col "method" 10 col "MB/sec" 12 "MB/sec (small)"]
+
+foreach method methods [
+	large: dt [loop rounds [checksum/method data method]]
+	short: dt [loop size / small / 16 [checksum/method msg method]]
+	print [
+		col method 10
+		col mbs size * rounds large 12
+		mbs size / 16 short
+	]
+]
+
+print [col "compress" 10 col mbs size dt [compress data] 12 "(includes CRC32)"]
@@ -0,0 +1,60 @@
+REBOL [
+	Title: "Benchmark: LOAD of numeric data"
+	Rights: {
+		Copyright 2012 REBOL Technologies
+		REBOL is a trademark of REBOL Technologies
+	}
+	License: {
+		Licensed under the Apache License, Version 2.0
+		See: http://www.apache.org/licenses/LICENSE-2.0
+	}
+	Purpose: {
+		Times LOAD (the scanner) of numeric datasets as text, and
+		checks that the loaded values are the ones that were molded.
+		Run with: r3 bench-load.r
+	}
+]
+
+size: 1'000'000	; values per dataset
+
+col: func [value width] [
+	value: form value
+	head insert/dup tail value " " width - length? value
+]
+
+rate: func [n time] [
+	time: to decimal! time
+	either zero? time [0] [to integer! n / time]
+]
+
+report: func [name values /local text t data] [
+	text: mold/only values
+	t: dt [data: load text]
+	print [
+		col name 20 col t 16 col rate size t 12 "values/sec"
+		col rate (length? text) / 1048576 t 6 "MB/sec"
+	]
+	if not equal? data values [print "** LOAD does not give the same values"]
+]
+
+random/seed 1
+
+ints: make block! size
+repeat i size [append ints (random 2'000'000'000) - 1'000'000'000]
+
+small: make block! size
+repeat i size [append small random 1000]
+
+decs: make block! size
+repeat i size [append decs (random 1.0) * (10 ** ((random 40) - 20))]
+
+prices: make block! size
+repeat i size [append prices (random 100'000) / 100.0]
+
+print ["Values per dataset:" size]
+print [col "dataset" 20 col "time" 16 "rate"]
+
+report "integers" ints
+report "small integers" small
+report "decimals" decs
+report "prices" prices
@@ -0,0 +1,58 @@
+REBOL [
+	Title: "Benchmark: MOLD and FORM of numbers"
+	Rights: {
+		Copyright 2012 REBOL Technologies
+		REBOL is a trademark of REBOL Technologies
+	}
+	License: {
+		Licensed under the Apache License, Version 2.0
+		See: http://www.apache.org/licenses/LICENSE-2.0
+	}
+	Purpose: {
+		Times MOLD and FORM of large numeric blocks and vectors, and
+		checks that the molded text loads back to the same values.
+		Run with: r3 bench-mold.r
+	}
+]
+
+size: 1'000'000	; values per dataset
+
+col: func [value width] [
+	value: form value
+	head insert/dup tail value " " width - length? value
+]
+
+rate: func [n time] [
+	time: to decimal! time
+	either zero? time [0] [to integer! n / time]
+]
+
+report: func [name data /local t text] [
+	t: dt [text: mold data]
+	print [col name 20 col t 16 col rate size t 12 "values/sec (mold)"]
+	t: dt [form data]
+	print [col "" 20 col t 16 col rate size t 12 "values/sec (form)"]
+	if block? data [
+		if not equal? data load text [print "** MOLD does not load back the same"]
+	]
+]
+
+random/seed 1
+
+ints: make block! size
+repeat i size [append ints (random 2'000'000'000) - 1'000'000'000]
+
+decs: make block! size
+repeat i size [append decs (random 1.0) * (10 ** ((random 40) - 20))]
+
+short: make block! size
+repeat i size [append short (random 100'000) / 100.0]
+
+print ["Values per dataset:" size]
+print [col "dataset" 20 col "time" 16 "rate"]
+
+report "integer block" ints
+report "decimal block" decs
+report "short decimals" short
+report "integer! 32 vector" make vector! compose [integer! 32 (ints)]
+report "decimal! 64 vector" make vector! compose [decimal! 64 (decs)]
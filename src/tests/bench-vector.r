@@ -0,0 +1,78 @@
+REBOL [
+	Title: "Benchmark: vector! math"
+	Rights: {
+		Copyright 2012 REBOL Technologies
+		REBOL is a trademark of REBOL Technologies
+	}
+	License: {
+		Licensed under the Apache License, Version 2.0
+		See: http://www.apache.org/licenses/LICENSE-2.0
+	}
+	Purpose: {
+		Compares the native element-wise vector ops and reductions
+		with the same work done by an interpreted loop, for each
+		element type. Run with: r3 bench-vector.r
+	}
+]
+
+size: 100'000	; elements per vector
+rounds: 20		; native ops are timed over this many runs
+
+types: [
+	[integer! 8] [integer! 16] [integer! 32] [integer! 64]
+	[unsigned integer! 8] [unsigned integer! 32]
+	[decimal! 32] [decimal! 64]
+]
+
+fill: func [spec /local v] [
+	v: make vector! append copy spec size
+	repeat i size [v/:i: i // 100 + 1]
+	v
+]
+
+time-it: func [n block /local t] [
+	t: dt [loop n block]
+	t / n
+]
+
+col: func [value width] [
+	value: form value
+	head insert/dup tail value " " width - length? value
+]
+
+report: func [name native loop /local ratio] [
+	ratio: either zero? native [0] [to integer! loop / native]
+	print [col name 12 col native 20 col loop 20 ratio "x"]
+]
+
+print ["Vector size:" size]
+print [col "op" 12 col "native" 20 col "loop" 20 "speedup"]
+
+foreach spec types [
+	print ["^/--" mold spec]
+	a: fill spec
+	b: fill spec
+	c: fill spec
+
+	report "add" time-it rounds [add a b] time-it 1 [
+		repeat i size [c/:i: a/:i + b/:i]
+	]
+	report "multiply" time-it rounds [multiply a 3] time-it 1 [
+		repeat i size [c/:i: a/:i * 3]
+	]
+	report "divide" time-it rounds [divide a 2] time-it 1 [
+		repeat i size [c/:i: a/:i / 2]
+	]
+	report "maximum" time-it rounds [maximum a 50] time-it 1 [
+		repeat i size [c/:i: max a/:i 50]
+	]
+	report "sum" time-it rounds [vector-sum a] time-it 1 [
+		s: 0 repeat i size [s: s + a/:i]
+	]
+	report "min" time-it rounds [vector-min a] time-it 1 [
+		s: a/1 repeat i size [s: min s a/:i]
+	]
+	report "dot" time-it rounds [vector-dot a b] time-it 1 [
+		s: 0 repeat i size [s: s + (a/:i * b/:i)]
+	]
+]
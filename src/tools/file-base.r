@@ -55,6 +55,8 @@ core: [
 	n-sets.c
 	n-strings.c
 	n-system.c
+	p-checksum.c
+	p-compress.c
 	p-clipboard.c
 	p-console.c
 	p-dir.c
@@ -105,6 +107,7 @@ core: [
 	u-parse.c
 	u-png.c
 	u-sha1.c
+	u-sha256.c
 	u-zlib.c
 ]
 
@@ -24,15 +24,15 @@ systems: [
 	[0.2.04 "osx"        osx    [+OS NCM -LM]]			; no shared lib possible
 	[0.2.05 "osxi"       osx    [ARC +O1 NPS PIC NCM HID STX -LM]]
 	[0.3.01 "win32"      win32  [+O2 UNI W32 WIN S4M EXE DIR -LM]]
-	[0.4.02 "linux"      posix  [+O2 LDL ST1 -LM]]		; libc 2.3
-	[0.4.03 "linux"      posix  [+O2 HID LDL ST1 -LM]]	; libc 2.5
-	[0.4.04 "linux"      posix  [+O2 HID LDL ST1 M32 -LM]]	; libc 2.11
-	[0.4.10 "linux_ppc"  posix  [+O1 HID LDL ST1 -LM]]
-	[0.4.20 "linux_arm"  posix  [+O2 HID LDL ST1 -LM]]
-	[0.4.30 "linux_mips" posix  [+O2 HID LDL ST1 -LM]]  ; glibc does not need C++
+	[0.4.02 "linux"      posix  [+O2 F64 LDL PTH ST1 -LM]]	; libc 2.3
+	[0.4.03 "linux"      posix  [+O2 F64 HID LDL PTH ST1 -LM]]	; libc 2.5
+	[0.4.04 "linux"      posix  [+O2 F64 HID LDL PTH ST1 M32 -LM]]	; libc 2.11
+	[0.4.10 "linux_ppc"  posix  [+O1 F64 HID LDL PTH ST1 -LM]]
+	[0.4.20 "linux_arm"  posix  [+O2 F64 HID LDL PTH ST1 -LM]]
+	[0.4.30 "linux_mips" posix  [+O2 F64 HID LDL PTH ST1 -LM]]  ; glibc does not need C++
 	[0.5.75 "haiku"      posix  [+O2 ST1 NWK]]
-	[0.7.02 "freebsd"    posix  [+O1 C++ ST1 -LM]]
-	[0.9.04 "openbsd"    posix  [+O1 C++ ST1 -LM]]
+	[0.7.02 "freebsd"    posix  [+O1 C++ PTH ST1 -LM]]
+	[0.9.04 "openbsd"    posix  [+O1 C++ PTH ST1 -LM]]
 	[0.13.01 "android_arm"  posix  [HID F64 LDL LLOG -LM CST]]
 ]
 
@@ -59,6 +59,7 @@ linker-flags: [
 	STA: "--strip-all"
 	C++: "-lstdc++" ; link with stdc++
 	LDL: "-ldl"     ; link with dynamic lib lib
+	PTH: "-lpthread" ; link with POSIX threads
 	LLOG: "-llog"	; on Android, link with liblog.so
 	ARC: "-arch i386" ; x86 32 bit architecture (OSX)
 	M32: "-m32"       ; use 32-bit memory model (Linux x64)